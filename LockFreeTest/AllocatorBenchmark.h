@@ -0,0 +1,400 @@
+//
+//  AllocatorBenchmark.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef AllocatorBenchmark_h
+#define AllocatorBenchmark_h
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BenchmarkRunner.h"
+#include "../Shared/Memory/MemoryPool.h"
+#include "../Shared/LockFree/ShardedCounter.h"
+
+#if PLATFORM_LINUX
+#include <unistd.h>
+#endif
+
+// objects held by each larson thread
+#define ALLOCATOR_LARSON_SLOTS 1024
+
+// thread generations of larson in a run
+#define ALLOCATOR_LARSON_ROUNDS 10
+
+// capacity of the xmalloc producer/consumer channels (must be power of 2)
+#define ALLOCATOR_XMALLOC_CHANNEL_SIZE 1024
+
+// objects allocated (and kept alive) by each thread churn thread
+#define ALLOCATOR_CHURN_OBJECTS 256
+#define ALLOCATOR_CHURN_KEPT 64
+
+// interval of the rss samples
+#define ALLOCATOR_SAMPLE_INTERVAL_MS 20
+
+// resident set size of the process (0 where unknown)
+inline uint64_t allocator_get_rss() {
+#if PLATFORM_LINUX
+    FILE *file = std::fopen("/proc/self/statm", "r");
+    if(file == nullptr)
+        return 0;
+    unsigned long long total = 0, resident = 0;
+    int matched = std::fscanf(file, "%llu %llu", &total, &resident);
+    std::fclose(file);
+    return matched == 2 ? (uint64_t)resident * (uint64_t)sysconf(_SC_PAGESIZE) : 0;
+#else
+    return 0;
+#endif
+}
+
+// memory_pool size classes only go up to BLOCK_SIZE_LIST[NUM_BLOCK_SIZE - 1]
+struct pool_allocator {
+    static const char *get_name() { return "memory_pool"; }
+    static void *allocate(size_t size) { return global_memory_pool.allocate(size); }
+    static void free(void *ptr) { global_memory_pool.free(ptr); }
+};
+
+struct system_allocator {
+    static const char *get_name() { return "malloc"; }
+    static void *allocate(size_t size) { return std::malloc(size); }
+    static void free(void *ptr) { std::free(ptr); }
+};
+
+struct allocator_result {
+    std::string scenario;
+    std::string allocator;
+    int num_threads = 0;
+    double ops_per_sec = 0;
+    uint64_t rss_begin = 0;
+    uint64_t rss_peak = 0;
+    // after every object of the run has been freed
+    uint64_t rss_end = 0;
+    uint64_t peak_live_bytes = 0;
+    std::vector<uint64_t> rss_samples;
+
+    // resident growth per requested byte at the peak (1.0 : no overhead)
+    double get_fragmentation() const {
+        return peak_live_bytes > 0 ? (double)(rss_peak - std::min(rss_peak, rss_begin)) / peak_live_bytes : 0.0;
+    }
+};
+
+// Allocator stress benchmark
+//
+// Scenarios (allocation sizes stay in the memory_pool size classes):
+// - larson : threads replace random objects of a slot array, and every
+//   round a new generation of threads takes over the arrays of others, so
+//   objects are freed by threads that didn't allocate them (server churn).
+// - xmalloc : producer threads allocate, consumer threads free (every free
+//   is a cross-thread free).
+// - size_* : batches of one size (or mixed sizes) freed in reverse.
+// - thread_churn : short-lived threads leaving objects for the next ones.
+// Requested bytes are tracked to relate the resident size to live data.
+template<typename allocator_t>
+class allocator_benchmark {
+public:
+    static std::vector<std::string> get_scenarios() {
+        return { "larson", "xmalloc", "size_16", "size_64", "size_128", "size_mixed", "thread_churn" };
+    }
+
+    allocator_result run(const std::string &scenario, int num_threads, int duration_ms) {
+        allocator_result result;
+        result.scenario = scenario;
+        result.allocator = allocator_t::get_name();
+        result.num_threads = num_threads;
+        result.rss_begin = allocator_get_rss();
+        start_sampler(result);
+
+        uint64_t num_ops = 0;
+        auto time_begin = std::chrono::steady_clock::now();
+        if(scenario == "larson")
+            num_ops = run_larson(num_threads, duration_ms);
+        else if(scenario == "xmalloc")
+            num_ops = run_xmalloc(num_threads, duration_ms, result);
+        else if(scenario == "thread_churn")
+            num_ops = run_thread_churn(num_threads, duration_ms);
+        else if(scenario == "size_mixed")
+            num_ops = run_size(num_threads, duration_ms, 0);
+        else if(scenario.compare(0, 5, "size_") == 0)
+            num_ops = run_size(num_threads, duration_ms, (size_t)std::atoi(scenario.c_str() + 5));
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - time_begin;
+
+        stop_sampler();
+        result.rss_end = allocator_get_rss();
+        result.ops_per_sec = num_ops / elapsed.count();
+        return result;
+    }
+
+    static void print(std::ostream &os, const std::vector<allocator_result> &results, const std::string &format) {
+        if(format == "csv") {
+            os << "scenario,allocator,threads,ops_per_sec,rss_begin,rss_peak,rss_end,peak_live_bytes,fragmentation,rss_samples" << std::endl;
+            for(const allocator_result &result : results) {
+                os << result.scenario << "," << result.allocator << "," << result.num_threads << "," << result.ops_per_sec << ","
+                   << result.rss_begin << "," << result.rss_peak << "," << result.rss_end << "," << result.peak_live_bytes << ","
+                   << result.get_fragmentation() << ",";
+                for(size_t i = 0; i < result.rss_samples.size(); i++)
+                    os << (i > 0 ? ";" : "") << result.rss_samples[i];
+                os << std::endl;
+            }
+        }
+        else if(format == "json") {
+            os << "{\"allocators\":[";
+            for(size_t i = 0; i < results.size(); i++) {
+                const allocator_result &result = results[i];
+                os << (i > 0 ? "," : "") << std::endl
+                   << "  {\"scenario\":\"" << json_escape(result.scenario) << "\",\"allocator\":\"" << json_escape(result.allocator) << "\",\"threads\":" << result.num_threads
+                   << ",\"ops_per_sec\":" << result.ops_per_sec << ",\"rss_begin\":" << result.rss_begin << ",\"rss_peak\":" << result.rss_peak
+                   << ",\"rss_end\":" << result.rss_end << ",\"peak_live_bytes\":" << result.peak_live_bytes
+                   << ",\"fragmentation\":" << result.get_fragmentation() << ",\"rss_samples\":[";
+                for(size_t k = 0; k < result.rss_samples.size(); k++)
+                    os << (k > 0 ? "," : "") << result.rss_samples[k];
+                os << "]}";
+            }
+            os << std::endl << "]}" << std::endl;
+        }
+        else {
+            for(const allocator_result &result : results)
+                print_text_row(os, result);
+        }
+    }
+
+    static void print_text_row(std::ostream &os, const allocator_result &result) {
+        constexpr double MB = 1024.0 * 1024.0;
+        os << result.scenario << " " << result.allocator << " threads:" << result.num_threads << " " << result.ops_per_sec << " ops/sec"
+           << " rss begin:" << result.rss_begin / MB << "MB peak:" << result.rss_peak / MB << "MB end:" << result.rss_end / MB << "MB"
+           << " peak live:" << result.peak_live_bytes / MB << "MB fragmentation:" << result.get_fragmentation() << std::endl;
+    }
+
+private:
+    struct object_t {
+        void *ptr;
+        size_t size;
+    };
+
+    // sizes are multiples of 16 in [16, 128] when size is 0
+    static inline size_t pick_size(bench_random &random, size_t size) {
+        return size != 0 ? size : (size_t)(random.next() % NUM_BLOCK_SIZE + 1) * BLOCK_SIZE_ALIGNMENT;
+    }
+
+    inline void *allocate(size_t size) {
+        void *ptr = allocator_t::allocate(size);
+        // touches the memory like a real user would
+        *(volatile uint8_t*)ptr = 1;
+        live_bytes.add((int64_t)size);
+        return ptr;
+    }
+
+    inline void free(const object_t &object) {
+        live_bytes.add(-(int64_t)object.size);
+        allocator_t::free(object.ptr);
+    }
+
+    uint64_t run_larson(int num_threads, int duration_ms) {
+        std::vector<std::vector<object_t>> slots(num_threads, std::vector<object_t>(ALLOCATOR_LARSON_SLOTS, { nullptr, 0 }));
+        std::vector<uint64_t> ops(num_threads, 0);
+        int round_ms = std::max(1, duration_ms / ALLOCATOR_LARSON_ROUNDS);
+        for(int round = 0; round < ALLOCATOR_LARSON_ROUNDS; round++) {
+            std::atomic<bool> stop{false};
+            std::vector<std::thread> ts(num_threads);
+            for(int k = 0; k < num_threads; k++) {
+                ts[k] = std::thread([&, k, round]() {
+                    // the arrays move to another thread every round
+                    std::vector<object_t> &objects = slots[(k + round) % num_threads];
+                    bench_random random((uint64_t)(round * num_threads + k + 1));
+                    uint64_t count = 0;
+                    while(!stop.load(std::memory_order_relaxed)) {
+                        object_t &object = objects[random.next() % ALLOCATOR_LARSON_SLOTS];
+                        if(object.ptr != nullptr)
+                            free(object);
+                        object.size = pick_size(random, 0);
+                        object.ptr = allocate(object.size);
+                        count++;
+                    }
+                    ops[k] += count;
+                });
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(round_ms));
+            stop.store(true);
+            for(int k = 0; k < num_threads; k++)
+                ts[k].join();
+        }
+        for(std::vector<object_t> &objects : slots) {
+            for(object_t &object : objects) {
+                if(object.ptr != nullptr)
+                    free(object);
+            }
+        }
+        uint64_t total = 0;
+        for(uint64_t count : ops)
+            total += count;
+        return total;
+    }
+
+    // single-producer single-consumer channel
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) channel_t {
+        alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64_t> head{0};
+        alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64_t> tail{0};
+        // set by the producer after its last push
+        std::atomic<bool> done{false};
+        object_t objects[ALLOCATOR_XMALLOC_CHANNEL_SIZE];
+    };
+
+    uint64_t run_xmalloc(int num_threads, int duration_ms, allocator_result &result) {
+        int num_pairs = std::max(1, num_threads / 2);
+        result.num_threads = num_pairs * 2;
+        std::unique_ptr<channel_t[]> channels(new channel_t[num_pairs]);
+        std::vector<uint64_t> ops(num_pairs, 0);
+        std::atomic<bool> stop{false};
+        std::vector<std::thread> ts;
+        for(int k = 0; k < num_pairs; k++) {
+            channel_t &channel = channels[k];
+            ts.push_back(std::thread([&, k]() {
+                bench_random random((uint64_t)k + 1);
+                while(!stop.load(std::memory_order_relaxed)) {
+                    uint64_t head = channel.head.load(std::memory_order_relaxed);
+                    if(head - channel.tail.load(std::memory_order_acquire) >= ALLOCATOR_XMALLOC_CHANNEL_SIZE) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    object_t &object = channel.objects[head & (ALLOCATOR_XMALLOC_CHANNEL_SIZE - 1)];
+                    object.size = pick_size(random, 0);
+                    object.ptr = allocate(object.size);
+                    channel.head.store(head + 1, std::memory_order_release);
+                }
+                channel.done.store(true, std::memory_order_release);
+            }));
+            ts.push_back(std::thread([&, k]() {
+                uint64_t count = 0;
+                for(;;) {
+                    uint64_t tail = channel.tail.load(std::memory_order_relaxed);
+                    // read before head, so a channel empty after done holds nothing more
+                    bool done = channel.done.load(std::memory_order_acquire);
+                    if(tail == channel.head.load(std::memory_order_acquire)) {
+                        if(done)
+                            break;
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    free(channel.objects[tail & (ALLOCATOR_XMALLOC_CHANNEL_SIZE - 1)]);
+                    channel.tail.store(tail + 1, std::memory_order_release);
+                    count++;
+                }
+                ops[k] = count;
+            }));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
+        stop.store(true);
+        for(std::thread &t : ts)
+            t.join();
+        uint64_t total = 0;
+        for(uint64_t count : ops)
+            total += count;
+        return total;
+    }
+
+    uint64_t run_size(int num_threads, int duration_ms, size_t size) {
+        constexpr int batch_size = 64;
+        std::vector<uint64_t> ops(num_threads, 0);
+        std::atomic<bool> stop{false};
+        std::vector<std::thread> ts(num_threads);
+        for(int k = 0; k < num_threads; k++) {
+            ts[k] = std::thread([&, k]() {
+                bench_random random((uint64_t)k + 1);
+                object_t batch[batch_size];
+                uint64_t count = 0;
+                while(!stop.load(std::memory_order_relaxed)) {
+                    for(int i = 0; i < batch_size; i++) {
+                        batch[i].size = pick_size(random, size);
+                        batch[i].ptr = allocate(batch[i].size);
+                    }
+                    for(int i = batch_size - 1; i >= 0; i--)
+                        free(batch[i]);
+                    count += batch_size;
+                }
+                ops[k] = count;
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
+        stop.store(true);
+        uint64_t total = 0;
+        for(int k = 0; k < num_threads; k++) {
+            ts[k].join();
+            total += ops[k];
+        }
+        return total;
+    }
+
+    uint64_t run_thread_churn(int num_threads, int duration_ms) {
+        // objects left by the previous generation and by the current one
+        std::vector<std::vector<object_t>> kept[2] = { std::vector<std::vector<object_t>>(num_threads), std::vector<std::vector<object_t>>(num_threads) };
+        uint64_t total = 0;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(duration_ms);
+        for(uint64_t generation = 0; std::chrono::steady_clock::now() < deadline; generation++) {
+            std::vector<std::thread> ts(num_threads);
+            for(int k = 0; k < num_threads; k++) {
+                ts[k] = std::thread([&, k, generation]() {
+                    bench_random random(generation * num_threads + k + 1);
+                    // frees what an exited thread left behind
+                    std::vector<object_t> &objects = kept[(generation + 1) & 1][(k + 1) % num_threads];
+                    for(object_t &object : objects)
+                        free(object);
+                    objects.clear();
+                    std::vector<object_t> allocated(ALLOCATOR_CHURN_OBJECTS);
+                    for(object_t &object : allocated) {
+                        object.size = pick_size(random, 0);
+                        object.ptr = allocate(object.size);
+                    }
+                    for(size_t i = ALLOCATOR_CHURN_KEPT; i < allocated.size(); i++)
+                        free(allocated[i]);
+                    allocated.resize(ALLOCATOR_CHURN_KEPT);
+                    kept[generation & 1][k].swap(allocated);
+                });
+            }
+            for(int k = 0; k < num_threads; k++)
+                ts[k].join();
+            total += (uint64_t)num_threads * ALLOCATOR_CHURN_OBJECTS;
+        }
+        for(std::vector<std::vector<object_t>> &generation_kept : kept) {
+            for(std::vector<object_t> &objects : generation_kept) {
+                for(object_t &object : objects)
+                    free(object);
+            }
+        }
+        return total;
+    }
+
+    void start_sampler(allocator_result &result) {
+        sampling.store(true);
+        sampler = std::thread([this, &result]() {
+            while(sampling.load()) {
+                uint64_t rss = allocator_get_rss();
+                int64_t live = live_bytes.read();
+                result.rss_samples.push_back(rss);
+                result.rss_peak = std::max(result.rss_peak, rss);
+                result.peak_live_bytes = std::max<uint64_t>(result.peak_live_bytes, (uint64_t)std::max<int64_t>(live, 0));
+                std::this_thread::sleep_for(std::chrono::milliseconds(ALLOCATOR_SAMPLE_INTERVAL_MS));
+            }
+        });
+    }
+
+    void stop_sampler() {
+        sampling.store(false);
+        sampler.join();
+    }
+
+private:
+    sharded_gauge live_bytes;
+    std::atomic<bool> sampling{false};
+    std::thread sampler;
+};
+
+#endif /* AllocatorBenchmark_h */
@@ -0,0 +1,591 @@
+//
+//  BenchmarkRunner.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef BenchmarkRunner_h
+#define BenchmarkRunner_h
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../Platform/Platform.h"
+
+// linear sub-buckets per power of 2 (relative error below 1 / 2^bits)
+#define LATENCY_HISTOGRAM_SUB_BUCKET_BITS 5
+#define LATENCY_HISTOGRAM_SUB_BUCKETS (1 << LATENCY_HISTOGRAM_SUB_BUCKET_BITS)
+
+// largest recorded value is 2^bits - 1 (ns, about 18 minutes)
+#define LATENCY_HISTOGRAM_MAX_BITS 40
+
+// xorshift random generator for benchmark threads
+struct bench_random {
+    uint64_t state;
+
+    bench_random(uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ull + 1) {}
+
+    inline uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+inline int64_t steady_now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// text as the contents of a JSON string (quotes, backslashes and control characters escaped)
+inline std::string json_escape(const std::string &text) {
+    static const char hex_digits[] = "0123456789abcdef";
+    std::string escaped;
+    escaped.reserve(text.size());
+    for(char c : text) {
+        if(c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if((unsigned char)c < 0x20) {
+            escaped += "\\u00";
+            escaped += hex_digits[(unsigned char)c >> 4];
+            escaped += hex_digits[c & 0xf];
+        }
+        else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+// Latency histogram (HDR style)
+//
+// Values below the sub-bucket count are exact, larger ones fall into one of
+// LATENCY_HISTOGRAM_SUB_BUCKETS linear buckets of their power of 2, so the
+// relative error stays constant over the whole range. Not thread-safe, each
+// thread records into its own histogram and they are merged afterwards.
+class latency_histogram {
+public:
+    latency_histogram() : counts(NUM_BUCKETS, 0) {}
+
+    inline void record(uint64_t value) {
+        counts[get_index(value)]++;
+        total_count++;
+        total_value += value;
+        min_value = std::min(min_value, value);
+        max_value = std::max(max_value, value);
+    }
+
+    void merge(const latency_histogram &other) {
+        for(size_t i = 0; i < NUM_BUCKETS; i++)
+            counts[i] += other.counts[i];
+        total_count += other.total_count;
+        total_value += other.total_value;
+        min_value = std::min(min_value, other.min_value);
+        max_value = std::max(max_value, other.max_value);
+    }
+
+    void reset() {
+        std::fill(counts.begin(), counts.end(), 0);
+        total_count = 0;
+        total_value = 0;
+        min_value = UINT64_MAX;
+        max_value = 0;
+    }
+
+    uint64_t get_count() const { return total_count; }
+    uint64_t get_min() const { return total_count > 0 ? min_value : 0; }
+    uint64_t get_max() const { return max_value; }
+    double get_mean() const { return total_count > 0 ? (double)total_value / total_count : 0.0; }
+
+    // highest value equivalent to the bucket holding the percentile (0 ~ 100)
+    uint64_t get_percentile(double percentile) const {
+        if(total_count == 0)
+            return 0;
+        uint64_t rank = (uint64_t)std::ceil(percentile / 100.0 * total_count);
+        rank = std::max<uint64_t>(1, std::min(rank, total_count));
+        uint64_t seen = 0;
+        for(size_t i = 0; i < NUM_BUCKETS; i++) {
+            seen += counts[i];
+            if(seen >= rank)
+                return std::min(get_highest_value(i), max_value);
+        }
+        return max_value;
+    }
+
+private:
+    static constexpr size_t NUM_BUCKETS = (LATENCY_HISTOGRAM_MAX_BITS - LATENCY_HISTOGRAM_SUB_BUCKET_BITS + 1) * LATENCY_HISTOGRAM_SUB_BUCKETS;
+
+    static inline uint32_t get_msb(uint64_t value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return (uint32_t)index;
+#else
+        return 63 - (uint32_t)__builtin_clzll(value);
+#endif
+    }
+
+    static inline size_t get_index(uint64_t value) {
+        value = std::min<uint64_t>(value, (uint64_t(1) << LATENCY_HISTOGRAM_MAX_BITS) - 1);
+        if(value < LATENCY_HISTOGRAM_SUB_BUCKETS)
+            return (size_t)value;
+        uint32_t shift = get_msb(value) - LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+        return (size_t)shift * LATENCY_HISTOGRAM_SUB_BUCKETS + (size_t)(value >> shift);
+    }
+
+    static inline uint64_t get_highest_value(size_t index) {
+        if(index < LATENCY_HISTOGRAM_SUB_BUCKETS * 2)
+            return index;
+        uint32_t shift = (uint32_t)(index / LATENCY_HISTOGRAM_SUB_BUCKETS) - 1;
+        uint64_t sub_bucket = index - (size_t)shift * LATENCY_HISTOGRAM_SUB_BUCKETS;
+        return ((sub_bucket + 1) << shift) - 1;
+    }
+
+private:
+    std::vector<uint64_t> counts;
+    uint64_t total_count = 0;
+    uint64_t total_value = 0;
+    uint64_t min_value = UINT64_MAX;
+    uint64_t max_value = 0;
+};
+
+// command line options of the test program
+struct benchmark_options {
+    // legacy test sections (--test) and runner benchmarks (--bench)
+    std::vector<std::string> tests;
+    std::vector<std::string> benchmarks;
+    // allocator stress scenarios (--alloc)
+    std::vector<std::string> allocator_scenarios;
+    std::vector<int> thread_counts;
+    int warmup_ms = 100;
+    int duration_ms = 500;
+    int repetitions = 3;
+    // times one op out of sample_every (0 : no latency)
+    int sample_every = 16;
+    // hardware counters per op (--perf)
+    bool perf = false;
+    // binary trace of the run (needs USE_TRACE), and a trace to convert to JSON
+    std::string trace_path;
+    std::string trace_convert_path;
+    platform::platform_placement placement = platform::platform_placement::none;
+    // text, csv or json
+    std::string format = "text";
+    std::string output_path;
+    bool list = false;
+    bool help = false;
+    std::string error;
+
+    static std::vector<std::string> split(const std::string &text) {
+        std::vector<std::string> items;
+        size_t begin = 0;
+        while(begin <= text.size()) {
+            size_t end = text.find(',', begin);
+            if(end == std::string::npos)
+                end = text.size();
+            if(end > begin)
+                items.push_back(text.substr(begin, end - begin));
+            begin = end + 1;
+        }
+        return items;
+    }
+
+    // powers of 2 up to twice the usable cpus, plus the cpu count itself
+    static std::vector<int> get_sweep_thread_counts() {
+        int num_cpus = (int)platform::platform_get_topology().cpus.size();
+        std::vector<int> counts;
+        for(int count = 1; count <= num_cpus * 2; count *= 2)
+            counts.push_back(count);
+        if(std::find(counts.begin(), counts.end(), num_cpus) == counts.end())
+            counts.push_back(num_cpus);
+        std::sort(counts.begin(), counts.end());
+        return counts;
+    }
+
+    bool parse(int argc, const char *argv[]) {
+        for(int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            std::string value;
+            size_t equal = arg.find('=');
+            if(equal != std::string::npos) {
+                value = arg.substr(equal + 1);
+                arg = arg.substr(0, equal);
+            }
+            else if(arg != "--list" && arg != "--help" && arg != "--perf") {
+                if(i + 1 >= argc) {
+                    error = "missing value for option: " + arg;
+                    break;
+                }
+                value = argv[++i];
+            }
+
+            if(arg == "--list")
+                list = true;
+            else if(arg == "--help")
+                help = true;
+            else if(arg == "--perf")
+                perf = true;
+            else if(arg == "--test")
+                for(const std::string &item : split(value)) tests.push_back(item);
+            else if(arg == "--bench")
+                for(const std::string &item : split(value)) benchmarks.push_back(item);
+            else if(arg == "--alloc")
+                for(const std::string &item : split(value)) allocator_scenarios.push_back(item);
+            else if(arg == "--threads") {
+                if(value == "sweep")
+                    thread_counts = get_sweep_thread_counts();
+                else
+                    for(const std::string &item : split(value)) thread_counts.push_back(std::max(1, std::atoi(item.c_str())));
+            }
+            else if(arg == "--warmup")
+                warmup_ms = std::max(0, std::atoi(value.c_str()));
+            else if(arg == "--duration")
+                duration_ms = std::max(1, std::atoi(value.c_str()));
+            else if(arg == "--reps")
+                repetitions = std::max(1, std::atoi(value.c_str()));
+            else if(arg == "--sample")
+                sample_every = std::max(0, std::atoi(value.c_str()));
+            else if(arg == "--trace")
+                trace_path = value;
+            else if(arg == "--trace-convert")
+                trace_convert_path = value;
+            else if(arg == "--format")
+                format = value;
+            else if(arg == "--output")
+                output_path = value;
+            else if(arg == "--placement") {
+                if(value == "compact")
+                    placement = platform::platform_placement::compact;
+                else if(value == "scatter")
+                    placement = platform::platform_placement::scatter;
+                else if(value == "physical_cores")
+                    placement = platform::platform_placement::physical_cores;
+                else if(value != "none")
+                    error = "unknown placement: " + value;
+            }
+            else
+                error = "unknown option: " + arg;
+        }
+        if(format != "text" && format != "csv" && format != "json")
+            error = "unknown format: " + format;
+        if(thread_counts.empty())
+            thread_counts = { 1, 2, 4, 8 };
+        return error.empty();
+    }
+
+    bool has_test(const char *name) const {
+        return std::find(tests.begin(), tests.end(), name) != tests.end()
+            || std::find(tests.begin(), tests.end(), "all") != tests.end();
+    }
+
+    static void print_usage(std::ostream &os) {
+        os << "usage: LockFreeTest [options]" << std::endl
+           << "  --test name,...        runs the test sections (all : every section)" << std::endl
+           << "  --bench pattern,...    runs the benchmarks (name, prefix* or all)" << std::endl
+           << "  --alloc scenario,...   runs allocator stress scenarios on memory_pool and malloc (all : every scenario)" << std::endl
+           << "  --list                 lists the benchmarks" << std::endl
+           << "  --threads n,...|sweep  thread counts (default 1,2,4,8)" << std::endl
+           << "  --warmup ms            warmup before each repetition (default 100)" << std::endl
+           << "  --duration ms          measured time of each repetition (default 500)" << std::endl
+           << "  --reps n               repetitions (default 3)" << std::endl
+           << "  --sample n             times one op out of n (default 16, 0 : off)" << std::endl
+           << "  --perf                 reports hardware counters per op (Linux perf_event_open)" << std::endl
+           << "  --placement policy     none, compact, scatter or physical_cores" << std::endl
+           << "  --format type          text, csv or json" << std::endl
+           << "  --output path          writes the results to a file" << std::endl
+           << "  --trace path           records an event trace (USE_TRACE builds), path.json is written too" << std::endl
+           << "  --trace-convert path   converts a binary trace to Chrome JSON (to --output or path.json)" << std::endl;
+    }
+};
+
+// per-thread state handed to benchmark ops
+struct benchmark_thread {
+    uint32_t index;
+    uint32_t num_threads;
+    bench_random random;
+
+    benchmark_thread(uint32_t in_index, uint32_t in_num_threads) : index(in_index), num_threads(in_num_threads), random(in_index + 1) {}
+};
+
+typedef std::function<void(benchmark_thread&)> benchmark_op_t;
+
+// setup(num_threads) creates the shared state of a repetition and returns the op
+struct benchmark_case {
+    std::string name;
+    std::string description;
+    std::function<benchmark_op_t(int)> setup;
+};
+
+struct benchmark_result {
+    std::string name;
+    int num_threads = 0;
+    platform::platform_placement placement = platform::platform_placement::none;
+    std::vector<double> ops_per_sec;
+    latency_histogram latency;
+    // counters summed over the threads and repetitions of num_ops measured ops
+    uint64_t num_ops = 0;
+    platform::platform_perf_sample perf;
+    std::string perf_error;
+
+    // counter value per op, negative if not counted
+    double get_perf_per_op(uint32_t event) const {
+        if(!perf.valid[event] || num_ops == 0)
+            return -1.0;
+        return (double)perf.values[event] / num_ops;
+    }
+
+    double get_ipc() const {
+        if(!perf.valid[platform::PLATFORM_PERF_CYCLES] || !perf.valid[platform::PLATFORM_PERF_INSTRUCTIONS] || perf.values[platform::PLATFORM_PERF_CYCLES] == 0)
+            return -1.0;
+        return (double)perf.values[platform::PLATFORM_PERF_INSTRUCTIONS] / perf.values[platform::PLATFORM_PERF_CYCLES];
+    }
+
+    double get_mean() const {
+        double sum = 0;
+        for(double value : ops_per_sec)
+            sum += value;
+        return ops_per_sec.empty() ? 0.0 : sum / ops_per_sec.size();
+    }
+
+    double get_stddev() const {
+        if(ops_per_sec.size() < 2)
+            return 0.0;
+        double mean = get_mean();
+        double sum = 0;
+        for(double value : ops_per_sec)
+            sum += (value - mean) * (value - mean);
+        return std::sqrt(sum / (ops_per_sec.size() - 1));
+    }
+
+    double get_min() const { return ops_per_sec.empty() ? 0.0 : *std::min_element(ops_per_sec.begin(), ops_per_sec.end()); }
+    double get_max() const { return ops_per_sec.empty() ? 0.0 : *std::max_element(ops_per_sec.begin(), ops_per_sec.end()); }
+};
+
+// Benchmark runner
+//
+// Every selected case runs for each thread count and repetition: the threads
+// start together, run the op for the warmup period, then count ops (and time
+// one out of sample_every) until the measured period ends. Timing uses
+// steady_clock.
+class benchmark_runner {
+public:
+    void add(const std::string &name, const std::string &description, std::function<benchmark_op_t(int)> setup) {
+        cases.push_back({ name, description, std::move(setup) });
+    }
+
+    const std::vector<benchmark_case> &get_cases() const { return cases; }
+
+    // exact name, prefix followed by '*', or all
+    static bool matches(const std::string &name, const std::vector<std::string> &patterns) {
+        for(const std::string &pattern : patterns) {
+            if(pattern == "all" || pattern == name)
+                return true;
+            if(!pattern.empty() && pattern.back() == '*' && name.compare(0, pattern.size() - 1, pattern, 0, pattern.size() - 1) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    std::vector<benchmark_result> run(const benchmark_options &options, std::ostream *progress = nullptr) {
+        std::vector<benchmark_result> results;
+        for(const benchmark_case &bench : cases) {
+            if(!matches(bench.name, options.benchmarks))
+                continue;
+            for(int num_threads : options.thread_counts) {
+                benchmark_result result;
+                result.name = bench.name;
+                result.num_threads = num_threads;
+                result.placement = options.placement;
+                for(int rep = 0; rep < options.repetitions; rep++)
+                    result.ops_per_sec.push_back(run_once(bench, num_threads, options, result));
+                if(progress != nullptr)
+                    print_text_row(*progress, result);
+                results.push_back(std::move(result));
+            }
+        }
+        return results;
+    }
+
+    static void print(std::ostream &os, const std::vector<benchmark_result> &results, const std::string &format) {
+        if(format == "csv") {
+            os << "benchmark,threads,placement,repetitions,ops_per_sec_mean,ops_per_sec_min,ops_per_sec_max,ops_per_sec_stddev,"
+               << "latency_samples,latency_mean_ns,p50_ns,p90_ns,p99_ns,p999_ns,max_ns";
+            for(uint32_t event = 0; event < platform::PLATFORM_PERF_EVENT_COUNT; event++)
+                os << "," << platform::platform_get_perf_event_name(event) << "_per_op";
+            os << ",ipc" << std::endl;
+            for(const benchmark_result &result : results) {
+                os << result.name << "," << result.num_threads << "," << platform::platform_get_placement_name(result.placement) << ","
+                   << result.ops_per_sec.size() << "," << result.get_mean() << "," << result.get_min() << "," << result.get_max() << ","
+                   << result.get_stddev() << "," << result.latency.get_count() << "," << result.latency.get_mean() << ","
+                   << result.latency.get_percentile(50) << "," << result.latency.get_percentile(90) << ","
+                   << result.latency.get_percentile(99) << "," << result.latency.get_percentile(99.9) << ","
+                   << result.latency.get_max();
+                // empty cells for counters that weren't measured
+                for(uint32_t event = 0; event < platform::PLATFORM_PERF_EVENT_COUNT; event++) {
+                    os << ",";
+                    if(result.get_perf_per_op(event) >= 0)
+                        os << result.get_perf_per_op(event);
+                }
+                os << ",";
+                if(result.get_ipc() >= 0)
+                    os << result.get_ipc();
+                os << std::endl;
+            }
+        }
+        else if(format == "json") {
+            os << "{\"benchmarks\":[";
+            for(size_t i = 0; i < results.size(); i++) {
+                const benchmark_result &result = results[i];
+                os << (i > 0 ? "," : "") << std::endl
+                   << "  {\"name\":\"" << json_escape(result.name) << "\",\"threads\":" << result.num_threads
+                   << ",\"placement\":\"" << platform::platform_get_placement_name(result.placement) << "\",\"ops_per_sec\":[";
+                for(size_t k = 0; k < result.ops_per_sec.size(); k++)
+                    os << (k > 0 ? "," : "") << result.ops_per_sec[k];
+                os << "],\"ops_per_sec_mean\":" << result.get_mean() << ",\"ops_per_sec_stddev\":" << result.get_stddev()
+                   << ",\"latency_ns\":{\"samples\":" << result.latency.get_count() << ",\"mean\":" << result.latency.get_mean()
+                   << ",\"p50\":" << result.latency.get_percentile(50) << ",\"p90\":" << result.latency.get_percentile(90)
+                   << ",\"p99\":" << result.latency.get_percentile(99) << ",\"p999\":" << result.latency.get_percentile(99.9)
+                   << ",\"max\":" << result.latency.get_max() << "}";
+                if(result.perf.has_any()) {
+                    os << ",\"perf_per_op\":{";
+                    bool first = true;
+                    for(uint32_t event = 0; event < platform::PLATFORM_PERF_EVENT_COUNT; event++) {
+                        if(result.get_perf_per_op(event) < 0)
+                            continue;
+                        os << (first ? "" : ",") << "\"" << platform::platform_get_perf_event_name(event) << "\":" << result.get_perf_per_op(event);
+                        first = false;
+                    }
+                    if(result.get_ipc() >= 0)
+                        os << (first ? "" : ",") << "\"ipc\":" << result.get_ipc();
+                    os << "}";
+                }
+                else if(!result.perf_error.empty()) {
+                    os << ",\"perf_error\":\"" << json_escape(result.perf_error) << "\"";
+                }
+                os << "}";
+            }
+            os << std::endl << "]}" << std::endl;
+        }
+        else {
+            for(const benchmark_result &result : results)
+                print_text_row(os, result);
+        }
+    }
+
+    static void print_text_row(std::ostream &os, const benchmark_result &result) {
+        os << result.name << " threads:" << result.num_threads << " " << result.get_mean() << " ops/sec"
+           << " (min " << result.get_min() << ", max " << result.get_max() << ", stddev " << result.get_stddev() << ")";
+        if(result.latency.get_count() > 0) {
+            os << " latency p50:" << result.latency.get_percentile(50) << "ns p99:" << result.latency.get_percentile(99)
+               << "ns p99.9:" << result.latency.get_percentile(99.9) << "ns max:" << result.latency.get_max() << "ns";
+        }
+        if(result.perf.has_any()) {
+            for(uint32_t event = 0; event < platform::PLATFORM_PERF_EVENT_COUNT; event++) {
+                if(result.get_perf_per_op(event) >= 0)
+                    os << " " << platform::platform_get_perf_event_name(event) << "/op:" << result.get_perf_per_op(event);
+            }
+            if(result.get_ipc() >= 0)
+                os << " ipc:" << result.get_ipc();
+        }
+        else if(!result.perf_error.empty()) {
+            os << " (perf: " << result.perf_error << ")";
+        }
+        os << std::endl;
+    }
+
+private:
+    enum : uint32_t { PHASE_WARMUP, PHASE_MEASURE, PHASE_STOP };
+
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) thread_result_t {
+        uint64_t num_ops = 0;
+        latency_histogram latency;
+        platform::platform_perf_sample perf;
+        const char *perf_error = nullptr;
+    };
+
+    // adds the latency, op count and counters of the run to the result, returns ops/sec
+    static double run_once(const benchmark_case &bench, int num_threads, const benchmark_options &options, benchmark_result &out_result) {
+        benchmark_op_t op = bench.setup(num_threads);
+        std::vector<uint32_t> cpus = platform::platform_get_placement(options.placement, num_threads);
+        std::vector<thread_result_t> thread_results(num_threads);
+        std::vector<std::thread> ts(num_threads);
+        std::atomic<int> num_ready{0};
+        std::atomic<uint32_t> phase{PHASE_WARMUP};
+        uint64_t sample_every = (uint64_t)options.sample_every;
+
+        for(int k = 0; k < num_threads; k++) {
+            ts[k] = std::thread([&, k]() {
+                if(!cpus.empty())
+                    platform::platform_pin_current_thread(cpus[k]);
+                benchmark_thread thread(k, num_threads);
+                thread_result_t &result = thread_results[k];
+                // counters are opened per thread (a failure only disables them)
+                platform::platform_perf_counters counters;
+                if(options.perf && !counters.open())
+                    result.perf_error = counters.get_error();
+                num_ready.fetch_add(1);
+                while(num_ready.load(std::memory_order_relaxed) < num_threads)
+                    std::this_thread::yield();
+
+                uint32_t current_phase;
+                while((current_phase = phase.load(std::memory_order_relaxed)) == PHASE_WARMUP)
+                    op(thread);
+                counters.start();
+                while(current_phase == PHASE_MEASURE) {
+                    if(sample_every != 0 && result.num_ops % sample_every == 0) {
+                        int64_t op_begin = steady_now_ns();
+                        op(thread);
+                        result.latency.record((uint64_t)(steady_now_ns() - op_begin));
+                    }
+                    else {
+                        op(thread);
+                    }
+                    result.num_ops++;
+                    current_phase = phase.load(std::memory_order_relaxed);
+                }
+                counters.stop();
+                result.perf = counters.read();
+            });
+        }
+
+        while(num_ready.load() < num_threads)
+            std::this_thread::yield();
+        if(options.warmup_ms > 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(options.warmup_ms));
+        auto time_begin = std::chrono::steady_clock::now();
+        phase.store(PHASE_MEASURE);
+        std::this_thread::sleep_for(std::chrono::milliseconds(options.duration_ms));
+        phase.store(PHASE_STOP);
+        auto time_end = std::chrono::steady_clock::now();
+        for(int k = 0; k < num_threads; k++)
+            ts[k].join();
+
+        uint64_t num_ops = 0;
+        for(int k = 0; k < num_threads; k++) {
+            num_ops += thread_results[k].num_ops;
+            out_result.latency.merge(thread_results[k].latency);
+            out_result.perf.add(thread_results[k].perf);
+            if(thread_results[k].perf_error != nullptr)
+                out_result.perf_error = thread_results[k].perf_error;
+        }
+        out_result.num_ops += num_ops;
+        std::chrono::duration<double> elapsed = time_end - time_begin;
+        return num_ops / elapsed.count();
+    }
+
+private:
+    std::vector<benchmark_case> cases;
+};
+
+#endif /* BenchmarkRunner_h */
@@ -0,0 +1,383 @@
+//
+//  IpcBenchmark.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef IpcBenchmark_h
+#define IpcBenchmark_h
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BenchmarkRunner.h"
+#include "../Platform/PlatformSharedMemory.h"
+#include "../Shared/Memory/SharedRegion.h"
+#include "../Shared/LockFree/SharedRingQueue.h"
+
+#if SUPPORTS_PLATFORM_SHARED_MEMORY
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// size of the shared region of a run
+#define IPC_REGION_SIZE (64ull * 1024 * 1024)
+
+// capacity of the rings (must be power of 2)
+#define IPC_RING_CAPACITY 1024
+
+// bytes of a message, header included (a shared_region size class)
+#define IPC_MESSAGE_SIZE 64
+
+// header of a message block, the payload follows
+struct ipc_message_t {
+    uint64_t sequence;
+    uint32_t size;
+    uint32_t checksum;
+    uint8_t payload[IPC_MESSAGE_SIZE - 16];
+};
+static_assert(sizeof(ipc_message_t) == IPC_MESSAGE_SIZE, "ipc_message_t must fill a message!");
+
+struct ipc_result {
+    std::string name;
+    std::string transport;
+    uint64_t num_messages = 0;
+    double seconds = 0;
+    bool validated = false;
+
+    double get_messages_per_sec() const { return seconds > 0 ? num_messages / seconds : 0; }
+    double get_ns_per_message() const { return num_messages > 0 ? seconds * 1e9 / num_messages : 0; }
+};
+
+// Shared memory ring vs Unix domain socket between two processes
+//
+// - stream : the parent sends messages, the child checks the order and the
+//   checksum of every one of them.
+// - ping_pong : the child echoes every message, so a message is one round
+//   trip (on the ring the same block travels back, nothing is copied).
+// The socket sends one message per write(), like a sidecar protocol would.
+// Waiting sides yield, so both processes can share a single cpu.
+class ipc_benchmark {
+public:
+    static ipc_result run_shm_stream(uint64_t num_messages) {
+        ipc_result result{ "stream", "shm_ring", num_messages };
+        shared_region region;
+        shared_ring_queue ring;
+        if(!region.create(IPC_REGION_SIZE) || !region.attach() || !ring.create(&region, IPC_RING_CAPACITY))
+            return result;
+
+        auto time_begin = std::chrono::steady_clock::now();
+        pid_t pid = fork();
+        if(pid == 0) {
+            region.attach();
+            bool valid = true;
+            for(uint64_t i = 0; i < num_messages; i++) {
+                uint64_t offset;
+                while(!ring.try_dequeue(offset))
+                    std::this_thread::yield();
+                ipc_message_t *message = region.get_pointer<ipc_message_t>(offset);
+                valid &= message->sequence == i && message->checksum == get_checksum(message->payload, message->size);
+                region.free(offset);
+            }
+            region.detach();
+            _exit(valid ? 0 : 1);
+        }
+
+        for(uint64_t i = 0; i < num_messages; i++) {
+            uint64_t offset;
+            while((offset = region.allocate(IPC_MESSAGE_SIZE)) == 0)
+                std::this_thread::yield();
+            fill_message(region.get_pointer<ipc_message_t>(offset), i);
+            while(!ring.try_enqueue(offset))
+                std::this_thread::yield();
+        }
+        result.validated = wait_child(pid);
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - time_begin).count();
+        return result;
+    }
+
+    static ipc_result run_shm_ping_pong(uint64_t num_messages) {
+        ipc_result result{ "ping_pong", "shm_ring", num_messages };
+        shared_region region;
+        shared_ring_queue request, response;
+        if(!region.create(IPC_REGION_SIZE) || !region.attach() || !request.create(&region, IPC_RING_CAPACITY) || !response.create(&region, IPC_RING_CAPACITY))
+            return result;
+
+        auto time_begin = std::chrono::steady_clock::now();
+        pid_t pid = fork();
+        if(pid == 0) {
+            region.attach();
+            for(uint64_t i = 0; i < num_messages; i++) {
+                uint64_t offset;
+                while(!request.try_dequeue(offset))
+                    std::this_thread::yield();
+                region.get_pointer<ipc_message_t>(offset)->sequence++;
+                while(!response.try_enqueue(offset))
+                    std::this_thread::yield();
+            }
+            region.detach();
+            _exit(0);
+        }
+
+        bool valid = true;
+        for(uint64_t i = 0; i < num_messages; i++) {
+            uint64_t offset = region.allocate(IPC_MESSAGE_SIZE);
+            fill_message(region.get_pointer<ipc_message_t>(offset), i);
+            while(!request.try_enqueue(offset))
+                std::this_thread::yield();
+            uint64_t reply;
+            while(!response.try_dequeue(reply))
+                std::this_thread::yield();
+            valid &= reply == offset && region.get_pointer<ipc_message_t>(reply)->sequence == i + 1;
+            region.free(reply);
+        }
+        result.validated = wait_child(pid) && valid;
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - time_begin).count();
+        return result;
+    }
+
+    static ipc_result run_socket_stream(uint64_t num_messages) {
+        ipc_result result{ "stream", "unix_socket", num_messages };
+        int fds[2];
+        if(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+            return result;
+
+        auto time_begin = std::chrono::steady_clock::now();
+        pid_t pid = fork();
+        if(pid == 0) {
+            close(fds[0]);
+            bool valid = true;
+            ipc_message_t message;
+            for(uint64_t i = 0; i < num_messages && valid; i++) {
+                valid &= read_full(fds[1], &message, sizeof(message));
+                valid &= message.sequence == i && message.checksum == get_checksum(message.payload, message.size);
+            }
+            _exit(valid ? 0 : 1);
+        }
+
+        close(fds[1]);
+        ipc_message_t message;
+        for(uint64_t i = 0; i < num_messages; i++) {
+            fill_message(&message, i);
+            if(!write_full(fds[0], &message, sizeof(message)))
+                break;
+        }
+        close(fds[0]);
+        result.validated = wait_child(pid);
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - time_begin).count();
+        return result;
+    }
+
+    static ipc_result run_socket_ping_pong(uint64_t num_messages) {
+        ipc_result result{ "ping_pong", "unix_socket", num_messages };
+        int fds[2];
+        if(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+            return result;
+
+        auto time_begin = std::chrono::steady_clock::now();
+        pid_t pid = fork();
+        if(pid == 0) {
+            close(fds[0]);
+            ipc_message_t message;
+            for(uint64_t i = 0; i < num_messages; i++) {
+                if(!read_full(fds[1], &message, sizeof(message)))
+                    _exit(1);
+                message.sequence++;
+                if(!write_full(fds[1], &message, sizeof(message)))
+                    _exit(1);
+            }
+            _exit(0);
+        }
+
+        close(fds[1]);
+        bool valid = true;
+        ipc_message_t message;
+        for(uint64_t i = 0; i < num_messages && valid; i++) {
+            fill_message(&message, i);
+            valid &= write_full(fds[0], &message, sizeof(message)) && read_full(fds[0], &message, sizeof(message));
+            valid &= message.sequence == i + 1;
+        }
+        close(fds[0]);
+        result.validated = wait_child(pid) && valid;
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - time_begin).count();
+        return result;
+    }
+
+    // a producer dies right after claiming a slot : the consumer sees an
+    // empty ring until recover() turns the slot into a tombstone
+    static bool run_producer_crash() {
+        shared_region region;
+        shared_ring_queue ring;
+        if(!region.create(IPC_REGION_SIZE) || !region.attach() || !ring.create(&region, 8))
+            return false;
+        bool valid = ring.try_enqueue(1);
+        pid_t pid = fork();
+        if(pid == 0) {
+            region.attach();
+            ring.debug_claim_enqueue();
+            _exit(0);
+        }
+        valid &= wait_child(pid);
+        valid &= ring.try_enqueue(2);
+
+        uint64_t value = 0;
+        valid &= ring.try_dequeue(value) && value == 1;
+        valid &= !ring.try_dequeue(value);
+        valid &= ring.recover() == 1;
+        valid &= ring.try_dequeue(value) && value == 2;
+        valid &= !ring.try_dequeue(value);
+        valid &= region.release_dead_participants() == 1;
+        return valid;
+    }
+
+    // a consumer dies holding a message : recover() hands the block back
+    // and the ring, full until then, takes new messages again
+    static bool run_consumer_crash() {
+        shared_region region;
+        shared_ring_queue ring;
+        constexpr uint64_t capacity = 8;
+        if(!region.create(IPC_REGION_SIZE) || !region.attach() || !ring.create(&region, capacity))
+            return false;
+        bool valid = true;
+        std::vector<uint64_t> offsets;
+        for(uint64_t i = 0; i < capacity; i++) {
+            offsets.push_back(region.allocate(IPC_MESSAGE_SIZE));
+            valid &= ring.try_enqueue(offsets.back());
+        }
+        pid_t pid = fork();
+        if(pid == 0) {
+            region.attach();
+            ring.debug_claim_dequeue();
+            _exit(0);
+        }
+        valid &= wait_child(pid);
+
+        uint64_t value = 0;
+        for(uint64_t i = 1; i < capacity; i++)
+            valid &= ring.try_dequeue(value) && value == offsets[i];
+        valid &= !ring.try_enqueue(offsets[0]);
+        uint64_t lost = 0;
+        valid &= ring.recover([&](uint64_t offset) { lost = offset; }) == 1;
+        valid &= lost == offsets[0];
+        valid &= ring.try_enqueue(lost) && ring.try_dequeue(value) && value == lost;
+        valid &= region.release_dead_participants() == 1;
+        return valid;
+    }
+
+    // producers are killed at random points while the parent consumes; after
+    // recover() the ring must neither stall nor reorder a producer's messages
+    static bool run_kill_producer(int num_rounds, uint32_t &out_recovered) {
+        shared_region region;
+        shared_ring_queue ring;
+        if(!region.create(IPC_REGION_SIZE) || !region.attach() || !ring.create(&region, 64))
+            return false;
+        bool valid = true;
+        bench_random random(num_rounds);
+        out_recovered = 0;
+        for(int round = 0; round < num_rounds && valid; round++) {
+            pid_t pid = fork();
+            if(pid == 0) {
+                region.attach();
+                for(uint64_t i = 0; ; i++) {
+                    uint64_t offset;
+                    while((offset = region.allocate(IPC_MESSAGE_SIZE)) == 0)
+                        std::this_thread::yield();
+                    fill_message(region.get_pointer<ipc_message_t>(offset), i);
+                    while(!ring.try_enqueue(offset))
+                        std::this_thread::yield();
+                }
+            }
+
+            uint64_t next_sequence = 0;
+            auto consume = [&]() {
+                uint64_t offset;
+                while(ring.try_dequeue(offset)) {
+                    ipc_message_t *message = region.get_pointer<ipc_message_t>(offset);
+                    valid &= message->sequence >= next_sequence && message->checksum == get_checksum(message->payload, message->size);
+                    next_sequence = message->sequence + 1;
+                    region.free(offset);
+                }
+            };
+            int64_t deadline = steady_now_ns() + (int64_t)(random.next() % 5000 + 100) * 1000;
+            while(steady_now_ns() < deadline) {
+                consume();
+                std::this_thread::yield();
+            }
+            kill(pid, SIGKILL);
+            waitpid(pid, nullptr, 0);
+
+            consume();
+            out_recovered += ring.recover([&](uint64_t offset) { region.free(offset); });
+            consume();
+            region.release_dead_participants();
+
+            // the ring must be usable again
+            uint64_t value = 0;
+            valid &= ring.size() == 0 && ring.try_enqueue(12345) && ring.try_dequeue(value) && value == 12345;
+        }
+        return valid;
+    }
+
+    static void print_row(std::ostream &os, const ipc_result &result) {
+        os << result.name << " " << result.transport << " messages:" << result.num_messages
+           << " " << (uint64_t)result.get_messages_per_sec() << " msgs/sec " << (uint64_t)result.get_ns_per_message() << " ns/msg"
+           << (result.validated ? "" : " (validation failed)") << std::endl;
+    }
+
+private:
+    static uint32_t get_checksum(const uint8_t *data, uint32_t size) {
+        uint32_t hash = 2166136261u;
+        for(uint32_t i = 0; i < size; i++)
+            hash = (hash ^ data[i]) * 16777619u;
+        return hash;
+    }
+
+    static void fill_message(ipc_message_t *message, uint64_t sequence) {
+        message->sequence = sequence;
+        message->size = sizeof(message->payload);
+        for(uint32_t i = 0; i < message->size; i++)
+            message->payload[i] = (uint8_t)(sequence + i);
+        message->checksum = get_checksum(message->payload, message->size);
+    }
+
+    static bool read_full(int fd, void *data, size_t size) {
+        uint8_t *ptr = (uint8_t*)data;
+        while(size > 0) {
+            ssize_t n = read(fd, ptr, size);
+            if(n <= 0)
+                return false;
+            ptr += n;
+            size -= (size_t)n;
+        }
+        return true;
+    }
+
+    static bool write_full(int fd, const void *data, size_t size) {
+        const uint8_t *ptr = (const uint8_t*)data;
+        while(size > 0) {
+            ssize_t n = write(fd, ptr, size);
+            if(n <= 0)
+                return false;
+            ptr += n;
+            size -= (size_t)n;
+        }
+        return true;
+    }
+
+    static bool wait_child(pid_t pid) {
+        int status = 0;
+        if(waitpid(pid, &status, 0) != pid)
+            return false;
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+};
+
+#endif
+
+#endif /* IpcBenchmark_h */
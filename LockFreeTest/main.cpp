@@ -2,8 +2,21 @@
 #include <thread>
 #include <vector>
 #include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <mutex>
+#include <map>
+#include <unordered_map>
+#include <shared_mutex>
+#include <condition_variable>
+#include <queue>
+#include <cstring>
+#include <fstream>
 #include "../Platform/Platform.h"
 #include "../Shared/Shared.h"
+#include "BenchmarkRunner.h"
+#include "AllocatorBenchmark.h"
+#include "IpcBenchmark.h"
 
 // global variables
 spinlock_mutex global_mutex{4096};
@@ -54,26 +67,949 @@ template void lock_free_stack_thread_pop_main<platform_lf_stack_t>(platform_lf_s
 #endif
 template void lock_free_stack_thread_pop_main<lf_stack_t>(lf_stack_t*, int, int, int*);
 
-// validation
+// keeps the results of benchmark lookups alive (added to from every benchmark thread)
+std::atomic<int64_t> bench_sink{0};
+
+// std::unordered_map behind a single spinlock_mutex (reference)
+template<typename K, typename V>
+class locked_unordered_map {
+public:
+    bool insert(const K &key, const V &value) {
+        scoped_lock<spinlock_mutex> lock{ &mutex };
+        return map.emplace(key, value).second;
+    }
+    
+    bool find(const K &key, V &out_value) {
+        scoped_lock<spinlock_mutex> lock{ &mutex };
+        auto it = map.find(key);
+        if(it == map.end())
+            return false;
+        out_value = it->second;
+        return true;
+    }
+    
+    bool erase(const K &key) {
+        scoped_lock<spinlock_mutex> lock{ &mutex };
+        return map.erase(key) > 0;
+    }
+    
+private:
+    spinlock_mutex mutex;
+    std::unordered_map<K, V> map;
+};
+
+typedef concurrent_hash_map<int, int> hash_map_t;
+typedef locked_unordered_map<int, int> locked_hash_map_t;
+constexpr int hash_map_key_range = 1 << 16;
+
+template <typename T>
+void hash_map_thread_main(T *map, int thread_index, int num_iteration, int read_percent) {
+    bench_random random(thread_index + 1);
+    int value = 0;
+    int64_t sum = 0;
+    for(int i = 0; i < num_iteration; i++) {
+        uint64_t r = random.next();
+        int key = (int)((r >> 8) % hash_map_key_range);
+        if((int)(r % 100) < read_percent)
+            sum += map->find(key, value) ? value : 0;
+        else if(r & 0x80)
+            map->insert(key, i);
+        else
+            map->erase(key);
+    }
+    bench_sink.fetch_add(sum, std::memory_order_relaxed);
+}
+
+template <typename T>
+double run_hash_map_benchmark(int num_threads, int num_iteration, int read_percent) {
+    T map;
+    for(int key = 0; key < hash_map_key_range; key += 2)
+        map.insert(key, key);
+    
+    std::vector<std::thread> ts(num_threads);
+    auto time_begin = std::chrono::steady_clock::now();
+    for(int k = 0; k < num_threads; k++) {
+        ts[k] = std::thread(hash_map_thread_main<T>, &map, k, num_iteration, read_percent);
+    }
+    for(int k = 0; k < num_threads; k++) {
+        ts[k].join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - time_begin;
+    return elapsed.count();
+}
+
+// std::map behind a single spinlock_mutex (reference)
+template<typename K, typename V>
+class locked_map {
+public:
+    bool insert(const K &key, const V &value) {
+        scoped_lock<spinlock_mutex> lock{ &mutex };
+        return map.emplace(key, value).second;
+    }
+    
+    bool find(const K &key, V &out_value) {
+        scoped_lock<spinlock_mutex> lock{ &mutex };
+        auto it = map.find(key);
+        if(it == map.end())
+            return false;
+        out_value = it->second;
+        return true;
+    }
+    
+    bool erase(const K &key) {
+        scoped_lock<spinlock_mutex> lock{ &mutex };
+        return map.erase(key) > 0;
+    }
+    
+    bool pop_min(K &out_key, V &out_value) {
+        scoped_lock<spinlock_mutex> lock{ &mutex };
+        if(map.empty())
+            return false;
+        auto it = map.begin();
+        out_key = it->first;
+        out_value = it->second;
+        map.erase(it);
+        return true;
+    }
+    
+    template<typename func_t>
+    void for_each_range(const K &from, const K &to, func_t func) {
+        scoped_lock<spinlock_mutex> lock{ &mutex };
+        for(auto it = map.lower_bound(from); it != map.end() && it->first < to; ++it)
+            func(it->first, it->second);
+    }
+    
+private:
+    spinlock_mutex mutex;
+    std::map<K, V> map;
+};
+
+typedef lf_skip_list<int, int> skip_list_t;
+typedef locked_map<int, int> locked_ordered_map_t;
+constexpr int skip_list_key_range = 1 << 16;
+constexpr int skip_list_scan_length = 64;
+
+// ordered map workload : 70% find, 10% insert, 10% erase, 10% range scan
+template <typename T>
+void ordered_map_thread_main(T *map, int thread_index, int num_iteration) {
+    bench_random random(thread_index + 1);
+    int value = 0;
+    int64_t sum = 0;
+    for(int i = 0; i < num_iteration; i++) {
+        uint64_t r = random.next();
+        int key = (int)((r >> 8) % skip_list_key_range);
+        int op = (int)(r % 10);
+        if(op < 7)
+            sum += map->find(key, value) ? value : 0;
+        else if(op == 7)
+            map->insert(key, i);
+        else if(op == 8)
+            map->erase(key);
+        else
+            map->for_each_range(key, key + skip_list_scan_length, [&sum](const int &, const int &v) { sum += v; });
+    }
+    bench_sink.fetch_add(sum, std::memory_order_relaxed);
+}
+
+// priority queue workload : push a random deadline, then pop the earliest one
+template <typename T>
+void priority_queue_thread_main(T *queue, int thread_index, int num_iteration) {
+    bench_random random(thread_index + 1);
+    int key, value;
+    for(int i = 0; i < num_iteration; i++) {
+        // keys are unique per thread to keep the insert from failing
+        key = (int)((random.next() % (1 << 20)) << 6) + thread_index;
+        queue->insert(key, i);
+        queue->pop_min(key, value);
+    }
+}
+
+template <typename T, bool priority_queue>
+double run_ordered_map_benchmark(int num_threads, int num_iteration) {
+    T map;
+    for(int key = 0; key < skip_list_key_range; key += 2)
+        map.insert(priority_queue ? (key << 6) + 63 : key, key);
+    
+    std::vector<std::thread> ts(num_threads);
+    auto time_begin = std::chrono::steady_clock::now();
+    for(int k = 0; k < num_threads; k++) {
+        if(priority_queue)
+            ts[k] = std::thread(priority_queue_thread_main<T>, &map, k, num_iteration);
+        else
+            ts[k] = std::thread(ordered_map_thread_main<T>, &map, k, num_iteration);
+    }
+    for(int k = 0; k < num_threads; k++) {
+        ts[k].join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - time_begin;
+    return elapsed.count();
+}
+
+// lock contention benchmark (fixed duration, counts acquisitions per thread)
+struct mutex_benchmark_result {
+    double elapsed;
+    double cpu_time;
+    uint64_t num_ops;
+    // coefficient of variation of per-thread acquisitions (0 : perfectly fair)
+    double fairness_cv;
+    bool validated;
+};
+
+struct alignas(PLATFORM_CACHE_LINE_SIZE) mutex_thread_counter {
+    uint64_t value;
+};
+
+template <typename mutex_t>
+void mutex_counter_thread_main(mutex_t *mutex, volatile uint64_t *counter, std::atomic<bool> *stop, mutex_thread_counter *acquisitions) {
+    uint64_t count = 0;
+    while(!stop->load(std::memory_order_relaxed)) {
+        mutex->lock();
+        (*counter)++;
+        mutex->unlock();
+        count++;
+    }
+    acquisitions->value = count;
+}
+
+template <typename mutex_t>
+mutex_benchmark_result run_mutex_benchmark(int num_threads, int duration_ms) {
+    mutex_t mutex;
+    volatile uint64_t counter = 0;
+    std::atomic<bool> stop{false};
+    std::vector<mutex_thread_counter> acquisitions(num_threads);
+    std::vector<std::thread> ts(num_threads);
+    
+    std::clock_t cpu_begin = std::clock();
+    auto time_begin = std::chrono::steady_clock::now();
+    for(int k = 0; k < num_threads; k++) {
+        ts[k] = std::thread(mutex_counter_thread_main<mutex_t>, &mutex, &counter, &stop, &acquisitions[k]);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
+    stop.store(true);
+    for(int k = 0; k < num_threads; k++) {
+        ts[k].join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - time_begin;
+    std::clock_t cpu_end = std::clock();
+    
+    mutex_benchmark_result result;
+    result.elapsed = elapsed.count();
+    result.cpu_time = (double)(cpu_end - cpu_begin) / CLOCKS_PER_SEC;
+    result.num_ops = 0;
+    for(int k = 0; k < num_threads; k++)
+        result.num_ops += acquisitions[k].value;
+    double mean = (double)result.num_ops / num_threads;
+    double variance = 0;
+    for(int k = 0; k < num_threads; k++)
+        variance += (acquisitions[k].value - mean) * (acquisitions[k].value - mean);
+    variance /= num_threads;
+    result.fairness_cv = mean > 0 ? std::sqrt(variance) / mean : 0;
+    result.validated = counter == result.num_ops;
+    return result;
+}
+
+template <typename mutex_t>
+void print_mutex_benchmark(const char *name, int num_threads, int duration_ms) {
+    mutex_benchmark_result result = run_mutex_benchmark<mutex_t>(num_threads, duration_ms);
+    std::cout << "threads:" << num_threads << " " << name << ":"
+              << " " << (result.num_ops / result.elapsed) << " ops/sec,"
+              << " cpu " << result.cpu_time << " sec (" << (100.0 * result.cpu_time / result.elapsed) << "% of wall),"
+              << " fairness cv " << result.fairness_cv
+              << (result.validated ? "" : " (validation failed!)") << std::endl;
+}
+
+// read-mostly snapshot (every field holds the same value, so torn reads are visible)
+struct config_snapshot_t {
+    uint64_t version;
+    uint64_t fields[3];
+};
+
+// snapshot behind an exclusive lock (reference)
+template<typename mutex_t>
+struct locked_config_holder {
+    mutex_t mutex;
+    config_snapshot_t value = {};
+    
+    config_snapshot_t load() {
+        scoped_lock<mutex_t> lock{ &mutex };
+        return value;
+    }
+    void store(const config_snapshot_t &new_value) {
+        scoped_lock<mutex_t> lock{ &mutex };
+        value = new_value;
+    }
+};
+
+// snapshot behind a reader-writer lock
+template<typename mutex_t>
+struct rw_config_holder {
+    mutex_t mutex;
+    config_snapshot_t value = {};
+    
+    config_snapshot_t load() {
+        scoped_read_lock<mutex_t> lock{ &mutex };
+        return value;
+    }
+    void store(const config_snapshot_t &new_value) {
+        scoped_lock<mutex_t> lock{ &mutex };
+        value = new_value;
+    }
+};
+
+template <typename holder_t>
+void read_mostly_thread_main(holder_t *holder, int write_permille, std::atomic<bool> *stop, mutex_thread_counter *ops, std::atomic<bool> *torn) {
+    bench_random random((uint64_t)(uintptr_t)ops);
+    uint64_t count = 0;
+    int64_t sum = 0;
+    while(!stop->load(std::memory_order_relaxed)) {
+        if((int)(random.next() % 1000) < write_permille) {
+            uint64_t version = random.next();
+            holder->store({ version, { version, version, version } });
+        }
+        else {
+            config_snapshot_t snapshot = holder->load();
+            if(snapshot.fields[0] != snapshot.version || snapshot.fields[1] != snapshot.version || snapshot.fields[2] != snapshot.version)
+                torn->store(true, std::memory_order_relaxed);
+            sum += (int64_t)snapshot.version;
+        }
+        count++;
+    }
+    ops->value = count;
+    bench_sink.fetch_add(sum, std::memory_order_relaxed);
+}
+
+template <typename holder_t>
+void print_read_mostly_benchmark(const char *name, int num_threads, int write_permille, int duration_ms) {
+    holder_t holder;
+    std::atomic<bool> stop{false};
+    std::atomic<bool> torn{false};
+    std::vector<mutex_thread_counter> ops(num_threads);
+    std::vector<std::thread> ts(num_threads);
+    
+    auto time_begin = std::chrono::steady_clock::now();
+    for(int k = 0; k < num_threads; k++) {
+        ts[k] = std::thread(read_mostly_thread_main<holder_t>, &holder, write_permille, &stop, &ops[k], &torn);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
+    stop.store(true);
+    for(int k = 0; k < num_threads; k++) {
+        ts[k].join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - time_begin;
+    
+    uint64_t num_ops = 0;
+    for(int k = 0; k < num_threads; k++)
+        num_ops += ops[k].value;
+    std::cout << "threads:" << num_threads << " " << name << ": " << (num_ops / elapsed.count()) << " ops/sec"
+              << (torn.load() ? " (validation failed!)" : "") << std::endl;
+}
+
+// average uncontended read of the snapshot
+template <typename holder_t>
+void print_read_latency(const char *name) {
+    constexpr int num_reads = 10000000;
+    holder_t holder;
+    int64_t sum = 0;
+    auto time_begin = std::chrono::steady_clock::now();
+    for(int i = 0; i < num_reads; i++)
+        sum += (int64_t)holder.load().version;
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - time_begin;
+    bench_sink.fetch_add(sum, std::memory_order_relaxed);
+    std::cout << name << " read: " << (elapsed.count() * 1e9 / num_reads) << " ns" << std::endl;
+}
+
+// std::condition_variable with the interface of parking_condition (reference)
+struct std_condition_adapter {
+    std::condition_variable condition;
+    
+    template<typename predicate_t>
+    void wait(std::mutex &mutex, predicate_t predicate) {
+        std::unique_lock<std::mutex> lock(mutex, std::adopt_lock);
+        condition.wait(lock, predicate);
+        lock.release();
+    }
+    void notify_one() { condition.notify_one(); }
+    void notify_all() { condition.notify_all(); }
+};
+
+// semaphore on std::mutex and std::condition_variable (reference)
+struct std_semaphore {
+    std::mutex mutex;
+    std::condition_variable condition;
+    uint32_t count = 0;
+    
+    void acquire() {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this]() { return count > 0; });
+        count--;
+    }
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            count++;
+        }
+        condition.notify_one();
+    }
+};
+
+// two threads passing a turn back and forth through a condition variable
+template<typename mutex_t, typename condition_t>
+double run_condition_ping_pong(int num_round_trips) {
+    mutex_t mutex;
+    condition_t condition;
+    int turn = 0;
+    
+    auto ping_pong = [&](int self) {
+        for(int i = 0; i < num_round_trips; i++) {
+            mutex.lock();
+            condition.wait(mutex, [&]() { return turn == self; });
+            turn = 1 - self;
+            mutex.unlock();
+            condition.notify_one();
+        }
+    };
+    
+    auto time_begin = std::chrono::steady_clock::now();
+    std::thread other(ping_pong, 1);
+    ping_pong(0);
+    other.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - time_begin;
+    return elapsed.count();
+}
+
+// two threads passing a turn back and forth through a pair of semaphores
+template<typename semaphore_t>
+double run_semaphore_ping_pong(int num_round_trips) {
+    semaphore_t semaphores[2];
+    
+    auto ping_pong = [&](int self) {
+        for(int i = 0; i < num_round_trips; i++) {
+            if(self == 1 || i > 0)
+                semaphores[self].acquire();
+            semaphores[1 - self].release();
+        }
+    };
+    
+    auto time_begin = std::chrono::steady_clock::now();
+    std::thread other(ping_pong, 1);
+    ping_pong(0);
+    semaphores[0].acquire();
+    other.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - time_begin;
+    return elapsed.count();
+}
+
+// time from a broadcast until the last of num_waiters threads has woken up
+template<typename wait_t, typename broadcast_t>
+double run_broadcast_latency(int num_waiters, wait_t wait, broadcast_t broadcast) {
+    std::vector<std::chrono::steady_clock::time_point> woken_at(num_waiters);
+    std::vector<std::thread> ts(num_waiters);
+    for(int k = 0; k < num_waiters; k++) {
+        ts[k] = std::thread([&, k]() {
+            wait();
+            woken_at[k] = std::chrono::steady_clock::now();
+        });
+    }
+    // let every waiter go to sleep
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    auto time_begin = std::chrono::steady_clock::now();
+    broadcast();
+    for(int k = 0; k < num_waiters; k++) {
+        ts[k].join();
+    }
+    auto last_woken = *std::max_element(woken_at.begin(), woken_at.end());
+    std::chrono::duration<double> elapsed = last_woken - time_begin;
+    return elapsed.count();
+}
+
+// low-rate producer / idle consumer test (values are push timestamps in ns, -1 stops a consumer)
+struct wake_latency_result {
+    double cpu_time;
+    double mean_latency_us;
+    double max_latency_us;
+    bool validated;
+};
+
+template <typename stack_t, bool blocking>
+wake_latency_result run_wake_latency_benchmark(int num_producers, int num_consumers, int num_messages, int interval_us) {
+    stack_t stack;
+    std::vector<std::vector<int64_t>> latencies(num_consumers);
+    std::atomic<int> num_consumed{0};
+    std::vector<std::thread> ts;
+    
+    std::clock_t cpu_begin = std::clock();
+    for(int k = 0; k < num_consumers; k++) {
+        ts.push_back(std::thread([&stack, &latencies, &num_consumed, k]() {
+            int64_t value = 0;
+            for(;;) {
+                if constexpr (blocking) {
+                    stack.pop_wait(value);
+                }
+                else {
+                    while(!stack.pop(value));
+                }
+                if(value < 0)
+                    break;
+                latencies[k].push_back(steady_now_ns() - value);
+                num_consumed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }));
+    }
+    std::vector<std::thread> producers;
+    for(int k = 0; k < num_producers; k++) {
+        producers.push_back(std::thread([&stack, num_messages, interval_us]() {
+            for(int i = 0; i < num_messages; i++) {
+                std::this_thread::sleep_for(std::chrono::microseconds(interval_us));
+                stack.push(steady_now_ns());
+            }
+        }));
+    }
+    for(std::thread &t : producers) {
+        t.join();
+    }
+    // the stack is LIFO, stop the consumers only after every message is taken
+    while(num_consumed.load() < num_producers * num_messages) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for(int k = 0; k < num_consumers; k++) {
+        stack.push(-1);
+    }
+    for(std::thread &t : ts) {
+        t.join();
+    }
+    std::clock_t cpu_end = std::clock();
+    
+    wake_latency_result result;
+    result.cpu_time = (double)(cpu_end - cpu_begin) / CLOCKS_PER_SEC;
+    int64_t total = 0;
+    int64_t max_latency = 0;
+    size_t count = 0;
+    for(std::vector<int64_t> &log : latencies) {
+        for(int64_t latency : log) {
+            total += latency;
+            max_latency = std::max(max_latency, latency);
+        }
+        count += log.size();
+    }
+    result.mean_latency_us = count > 0 ? (double)total / count / 1000.0 : 0;
+    result.max_latency_us = (double)max_latency / 1000.0;
+    result.validated = count == (size_t)num_producers * num_messages;
+    return result;
+}
+
+// thread placement of run_throughput_benchmark
+platform::platform_placement benchmark_placement = platform::platform_placement::none;
+
+// runs op(random) on every thread for a fixed duration, returns ops/sec
+template <typename op_t>
+double run_throughput_benchmark(int num_threads, int duration_ms, op_t op) {
+    std::atomic<bool> stop{false};
+    std::vector<mutex_thread_counter> ops(num_threads);
+    std::vector<std::thread> ts(num_threads);
+    std::vector<uint32_t> cpus = platform::platform_get_placement(benchmark_placement, num_threads);
+    
+    auto time_begin = std::chrono::steady_clock::now();
+    for(int k = 0; k < num_threads; k++) {
+        ts[k] = std::thread([&, k]() {
+            if(!cpus.empty())
+                platform::platform_pin_current_thread(cpus[k]);
+            bench_random random(k + 1);
+            uint64_t count = 0;
+            while(!stop.load(std::memory_order_relaxed)) {
+                op(random);
+                count++;
+            }
+            ops[k].value = count;
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
+    stop.store(true);
+    for(int k = 0; k < num_threads; k++) {
+        ts[k].join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - time_begin;
+    
+    uint64_t num_ops = 0;
+    for(int k = 0; k < num_threads; k++)
+        num_ops += ops[k].value;
+    return num_ops / elapsed.count();
+}
+
+// per-request statistics accumulated by worker threads
+struct request_stat_t {
+    uint64_t count = 0;
+    uint64_t total_latency = 0;
+    uint64_t max_latency = 0;
+    
+    void add(uint64_t latency) {
+        count++;
+        total_latency += latency;
+        max_latency = std::max(max_latency, latency);
+    }
+    
+    static request_stat_t merge(const request_stat_t &a, const request_stat_t &b) {
+        request_stat_t result;
+        result.count = a.count + b.count;
+        result.total_latency = a.total_latency + b.total_latency;
+        result.max_latency = std::max(a.max_latency, b.max_latency);
+        return result;
+    }
+};
+
+// actor mailbox message
+struct mailbox_message_t : public mpsc_queue_hook {
+    int producer_index;
+    int sequence;
+};
+
+typedef intrusive_mpsc_queue<mailbox_message_t> mailbox_queue_t;
+
+void mailbox_thread_post_main(mailbox_queue_t *queue, mailbox_message_t *messages, int producer_index, int num_iteration) {
+    for(int i = 0; i < num_iteration; i++) {
+        messages[i].producer_index = producer_index;
+        messages[i].sequence = i;
+        queue->push(&messages[i]);
+    }
+}
+
+// returns false if messages of a producer are received out of order
+bool mailbox_thread_consume_main(mailbox_queue_t *queue, int num_producers, int num_total_messages) {
+    std::vector<int> next_sequence(num_producers, 0);
+    bool in_order = true;
+    int received = 0;
+    while(received < num_total_messages) {
+        received += (int)queue->drain([&](mailbox_message_t *message) {
+            in_order &= message->sequence == next_sequence[message->producer_index];
+            next_sequence[message->producer_index] = message->sequence + 1;
+        });
+    }
+    return in_order && queue->empty();
+}
+
+// std::priority_queue behind spinlock_mutex with the interface of multi_queue (reference)
+template<typename V>
+struct locked_priority_queue {
+    typedef std::pair<uint64_t, V> entry_t;
+    spinlock_mutex mutex;
+    std::priority_queue<entry_t, std::vector<entry_t>, std::greater<entry_t>> queue;
+    
+    locked_priority_queue(uint32_t = 0) {}
+    
+    void push(uint64_t priority, const V &value) {
+        scoped_lock<spinlock_mutex> lock{ &mutex };
+        queue.push({ priority, value });
+    }
+    bool pop(uint64_t &out_priority, V &out_value) {
+        scoped_lock<spinlock_mutex> lock{ &mutex };
+        if(queue.empty())
+            return false;
+        out_priority = queue.top().first;
+        out_value = queue.top().second;
+        queue.pop();
+        return true;
+    }
+};
+
+struct rank_error_result {
+    double mean = 0;
+    uint64_t p99 = 0;
+    uint64_t max = 0;
+};
+
+// rank of every popped priority among the queued ones (0 : the exact minimum),
+// replayed on one thread so only the structural relaxation is measured
+template<typename queue_t>
+rank_error_result measure_rank_error(queue_t &queue, uint32_t num_prefill, uint32_t num_ops) {
+    constexpr uint32_t priority_bits = 20;
+    constexpr uint32_t num_priorities = 1u << priority_bits;
+    // fenwick tree of queued priorities
+    std::vector<uint32_t> tree(num_priorities + 1, 0);
+    auto add = [&](uint32_t priority, int32_t diff) {
+        for(uint32_t i = priority + 1; i <= num_priorities; i += i & (0 - i))
+            tree[i] += diff;
+    };
+    auto count_less = [&](uint32_t priority) {
+        uint64_t count = 0;
+        for(uint32_t i = priority; i > 0; i -= i & (0 - i))
+            count += tree[i];
+        return count;
+    };
+    
+    bench_random random(num_prefill);
+    for(uint32_t i = 0; i < num_prefill; i++) {
+        uint32_t priority = (uint32_t)(random.next() & (num_priorities - 1));
+        queue.push(priority, i);
+        add(priority, 1);
+    }
+    std::vector<uint64_t> ranks;
+    ranks.reserve(num_ops);
+    for(uint32_t i = 0; i < num_ops; i++) {
+        uint64_t priority;
+        uint32_t value;
+        if(queue.pop(priority, value)) {
+            ranks.push_back(count_less((uint32_t)priority));
+            add((uint32_t)priority, -1);
+        }
+        // timed work keeps arriving behind the current minimum
+        uint32_t new_priority = (uint32_t)(random.next() & (num_priorities - 1));
+        queue.push(new_priority, i);
+        add(new_priority, 1);
+    }
+    
+    rank_error_result result;
+    if(ranks.empty())
+        return result;
+    uint64_t sum = 0;
+    for(uint64_t rank : ranks)
+        sum += rank;
+    result.mean = (double)sum / ranks.size();
+    std::sort(ranks.begin(), ranks.end());
+    result.p99 = ranks[ranks.size() * 99 / 100];
+    result.max = ranks.back();
+    return result;
+}
+
+// benchmarks of the runner (--bench), shared state is created per repetition
+// push, then pop, around a prefilled queue
+template<typename queue_t>
+benchmark_op_t make_priority_queue_op(int num_threads) {
+    std::shared_ptr<queue_t> queue = std::make_shared<queue_t>((uint32_t)num_threads);
+    bench_random random(num_threads);
+    for(int i = 0; i < 65536; i++)
+        queue->push(random.next() & 0xFFFFF, i);
+    return [queue](benchmark_thread &thread) {
+        uint64_t priority = thread.random.next() & 0xFFFFF;
+        uint32_t value = (uint32_t)priority;
+        queue->push(priority, value);
+        queue->pop(priority, value);
+        bench_sink.fetch_add((int64_t)value, std::memory_order_relaxed);
+    };
+}
+
+template<typename mutex_t>
+benchmark_op_t make_locked_counter_op() {
+    struct locked_counter_t {
+        mutex_t mutex;
+        uint64_t value = 0;
+    };
+    std::shared_ptr<locked_counter_t> counter = std::make_shared<locked_counter_t>();
+    return [counter](benchmark_thread&) {
+        counter->mutex.lock();
+        counter->value++;
+        counter->mutex.unlock();
+    };
+}
+
+// 99.9% snapshot reads, 0.1% writes
+template<typename holder_t>
+benchmark_op_t make_read_mostly_op() {
+    std::shared_ptr<holder_t> holder = std::make_shared<holder_t>();
+    return [holder](benchmark_thread &thread) {
+        uint64_t r = thread.random.next();
+        if(r % 1000 == 0) {
+            holder->store({ r, { r, r, r } });
+        }
+        else {
+            config_snapshot_t snapshot = holder->load();
+            bench_sink.fetch_add((int64_t)snapshot.fields[r % 3], std::memory_order_relaxed);
+        }
+    };
+}
+
+void register_benchmarks(benchmark_runner &runner) {
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) atomic_counter_t {
+        std::atomic<uint64_t> value{0};
+    };
+    runner.add("atomic.fetch_add", "shared std::atomic counter", [](int) -> benchmark_op_t {
+        std::shared_ptr<atomic_counter_t> counter = std::make_shared<atomic_counter_t>();
+        return [counter](benchmark_thread&) { counter->value.fetch_add(1, std::memory_order_relaxed); };
+    });
+    runner.add("sharded_counter.add", "sharded_counter", [](int) -> benchmark_op_t {
+        std::shared_ptr<sharded_counter> counter = std::make_shared<sharded_counter>();
+        return [counter](benchmark_thread&) { counter->add(1); };
+    });
+    
+    // counter behind each lock
+    runner.add("spinlock_mutex.counter", "counter behind spinlock_mutex", [](int) { return make_locked_counter_op<spinlock_mutex>(); });
+    runner.add("ticket_mutex.counter", "counter behind ticket_mutex", [](int) { return make_locked_counter_op<ticket_mutex>(); });
+    runner.add("mcs_mutex.counter", "counter behind mcs_mutex", [](int) { return make_locked_counter_op<mcs_mutex>(); });
+    runner.add("clh_mutex.counter", "counter behind clh_mutex", [](int) { return make_locked_counter_op<clh_mutex>(); });
+    runner.add("std_mutex.counter", "counter behind std::mutex", [](int) { return make_locked_counter_op<std::mutex>(); });
+    
+    // read-mostly snapshot behind each reader lock (--sample shows the read-side latency)
+    runner.add("spinlock_mutex.read_mostly", "snapshot behind spinlock_mutex (99.9% reads)", [](int) { return make_read_mostly_op<locked_config_holder<spinlock_mutex>>(); });
+    runner.add("rw_spinlock_mutex.read_mostly", "snapshot behind rw_spinlock_mutex (99.9% reads)", [](int) { return make_read_mostly_op<rw_config_holder<rw_spinlock_mutex>>(); });
+    runner.add("std_shared_mutex.read_mostly", "snapshot behind std::shared_mutex (99.9% reads)", [](int) { return make_read_mostly_op<rw_config_holder<std::shared_mutex>>(); });
+    runner.add("asymmetric_rw_mutex.read_mostly", "snapshot behind asymmetric_rw_mutex (99.9% reads)", [](int) { return make_read_mostly_op<rw_config_holder<asymmetric_rw_mutex>>(); });
+    
+    // stack (push, then pop)
+    runner.add("lf_stack.push_pop", "lf_stack push and pop", [](int) -> benchmark_op_t {
+        std::shared_ptr<lf_stack<int>> stack = std::make_shared<lf_stack<int>>();
+        return [stack](benchmark_thread &thread) {
+            int value = (int)thread.random.next();
+            stack->push(value);
+            stack->pop(value);
+        };
+    });
+    runner.add("bounded_lf_stack.push_pop", "bounded_lf_stack push and pop (index + tag CAS)", [](int num_threads) -> benchmark_op_t {
+        std::shared_ptr<bounded_lf_stack<int>> stack = std::make_shared<bounded_lf_stack<int>>((uint32_t)num_threads * 2);
+        return [stack](benchmark_thread &thread) {
+            int value = (int)thread.random.next();
+            stack->push(value);
+            stack->pop(value);
+        };
+    });
+    runner.add("locked_stack.push_pop", "std::vector stack behind spinlock_mutex", [](int) -> benchmark_op_t {
+        struct locked_stack_t {
+            spinlock_mutex mutex;
+            std::vector<int> values;
+        };
+        std::shared_ptr<locked_stack_t> stack = std::make_shared<locked_stack_t>();
+        return [stack](benchmark_thread &thread) {
+            {
+                scoped_lock<spinlock_mutex> lock{ &stack->mutex };
+                stack->values.push_back((int)thread.random.next());
+            }
+            scoped_lock<spinlock_mutex> lock{ &stack->mutex };
+            if(!stack->values.empty())
+                stack->values.pop_back();
+        };
+    });
+    
+    // allocation (random size class, freed right away)
+    runner.add("memory_pool.alloc_free", "global_memory_pool allocate and free", [](int) -> benchmark_op_t {
+        return [](benchmark_thread &thread) {
+            void *ptr = global_memory_pool.allocate(BLOCK_SIZE_LIST[thread.random.next() % NUM_BLOCK_SIZE]);
+            bench_sink.fetch_add((int64_t)(uintptr_t)ptr, std::memory_order_relaxed);
+            global_memory_pool.free(ptr);
+        };
+    });
+    runner.add("malloc.alloc_free", "malloc and free", [](int) -> benchmark_op_t {
+        return [](benchmark_thread &thread) {
+            void *ptr = std::malloc(BLOCK_SIZE_LIST[thread.random.next() % NUM_BLOCK_SIZE]);
+            bench_sink.fetch_add((int64_t)(uintptr_t)ptr, std::memory_order_relaxed);
+            std::free(ptr);
+        };
+    });
+    runner.add("bounded_object_pool.alloc_free", "bounded_object_pool allocate and free", [](int num_threads) -> benchmark_op_t {
+        std::shared_ptr<bounded_object_pool<uint64_t>> pool = std::make_shared<bounded_object_pool<uint64_t>>((uint32_t)num_threads * 2);
+        return [pool](benchmark_thread &thread) {
+            uint64_t *ptr = pool->allocate(thread.random.next());
+            bench_sink.fetch_add((int64_t)(uintptr_t)ptr, std::memory_order_relaxed);
+            if(ptr != nullptr)
+                pool->free(ptr);
+        };
+    });
+    
+    // relaxed priority queue against one locked heap
+    runner.add("multi_queue.push_pop", "multi_queue push and pop (64K queued)", [](int num_threads) { return make_priority_queue_op<multi_queue<uint32_t>>(num_threads); });
+    runner.add("locked_priority_queue.push_pop", "std::priority_queue behind spinlock_mutex push and pop (64K queued)", [](int num_threads) { return make_priority_queue_op<locked_priority_queue<uint32_t>>(num_threads); });
+    
+    // hash map (90% find, 5% insert, 5% erase over 64K keys)
+    runner.add("concurrent_hash_map.mixed", "concurrent_hash_map 90/5/5 find/insert/erase", [](int) -> benchmark_op_t {
+        std::shared_ptr<concurrent_hash_map<int, int>> map = std::make_shared<concurrent_hash_map<int, int>>();
+        for(int i = 0; i < 65536; i += 2)
+            map->insert(i, i);
+        return [map](benchmark_thread &thread) {
+            uint64_t r = thread.random.next();
+            int key = (int)((r >> 8) & 0xFFFF);
+            uint32_t kind = (uint32_t)(r % 100);
+            int value;
+            if(kind < 90)
+                bench_sink.fetch_add(map->find(key, value), std::memory_order_relaxed);
+            else if(kind < 95)
+                map->insert(key, key);
+            else
+                map->erase(key);
+        };
+    });
+}
+
+// gathers the per-thread logs into one array (a thread log per task)
+std::vector<int> gather_value_log(int **value_log, int num_threads, int num_iteration) {
+    std::vector<int> values((size_t)num_threads * num_iteration);
+    parallel_for(0, num_threads, [&](size_t i) {
+        std::memcpy(&values[i * num_iteration], value_log[i], num_iteration * sizeof(int));
+    }, 1);
+    return values;
+}
+
+// validation (the popped values must be the same multiset as the pushed ones)
 bool validate_push_pop(int **push_value_log, int **pop_value_log, int num_push_threads, int num_push_iteration, int num_pop_threads, int num_pop_iteration) {
-    std::vector<int> push_vec, pop_vec;
-    for(int i = 0; i < num_push_threads; i++) {
-        for(int j = 0; j < num_push_iteration; j++)
-            push_vec.push_back(push_value_log[i][j]);
-    }
-    for(int i = 0; i < num_pop_threads; i++) {
-        for(int j = 0; j < num_pop_iteration; j++)
-            pop_vec.push_back(pop_value_log[i][j]);
-    }
-    //std::sort(push_vec.begin(), push_vec.end());
-    std::sort(pop_vec.begin(), pop_vec.end());
-    return push_vec == pop_vec;
+    if((size_t)num_push_threads * num_push_iteration != (size_t)num_pop_threads * num_pop_iteration)
+        return false;
+    std::vector<int> push_vec = gather_value_log(push_value_log, num_push_threads, num_push_iteration);
+    std::vector<int> pop_vec = gather_value_log(pop_value_log, num_pop_threads, num_pop_iteration);
+    parallel_radix_sort(push_vec.data(), push_vec.size());
+    parallel_radix_sort(pop_vec.data(), pop_vec.size());
+    size_t mismatch_count = parallel_reduce(0, push_vec.size(), (size_t)0, [&](size_t begin, size_t end) {
+        size_t count = 0;
+        for(size_t i = begin; i < end; i++)
+            count += push_vec[i] != pop_vec[i];
+        return count;
+    }, [](size_t a, size_t b) { return a + b; });
+    return mismatch_count == 0;
 }
 
 int main(int argc, const char * argv[]) {
+    benchmark_options options;
+    if(!options.parse(argc, argv) || options.help) {
+        if(!options.error.empty())
+            std::cerr << options.error << std::endl;
+        benchmark_options::print_usage(options.help ? std::cout : std::cerr);
+        return options.help ? 0 : 1;
+    }
+    
+#if USE_TRACE
+    if(!options.trace_convert_path.empty()) {
+        std::string json_path = options.output_path.empty() ? options.trace_convert_path + ".json" : options.output_path;
+        bool converted = tracer::convert_to_chrome_json(options.trace_convert_path.c_str(), json_path.c_str());
+        std::cout << (converted ? "Converted to " + json_path : "Failed to convert " + options.trace_convert_path) << std::endl;
+        return converted ? 0 : 1;
+    }
+    if(!options.trace_path.empty() && !global_tracer.start(options.trace_path.c_str())) {
+        std::cerr << "can't open " << options.trace_path << std::endl;
+        return 1;
+    }
+#else
+    if(!options.trace_path.empty() || !options.trace_convert_path.empty()) {
+        std::cerr << "tracing is compiled out (build with -DUSE_TRACE=1)" << std::endl;
+        return 1;
+    }
+#endif
+    
+    benchmark_runner runner;
+    register_benchmarks(runner);
+    if(options.list) {
+        for(const benchmark_case &bench : runner.get_cases())
+            std::cout << bench.name << " : " << bench.description << std::endl;
+        for(const std::string &scenario : allocator_benchmark<system_allocator>::get_scenarios())
+            std::cout << "--alloc " << scenario << std::endl;
+        return 0;
+    }
+    // without a selection, runs the atomic_flag test as before
+    if(options.tests.empty() && options.benchmarks.empty() && options.allocator_scenarios.empty())
+        options.tests.push_back("atomic_flag");
+    
     // test flags
-    constexpr bool test_atomic_flag = true;
-    constexpr bool test_lf_stack = false;
+    const bool test_atomic_flag = options.has_test("atomic_flag");
+    const bool test_lf_stack = options.has_test("lf_stack");
+    const bool test_hash_map = options.has_test("hash_map");
+    const bool test_skip_list = options.has_test("skip_list");
+    const bool test_mpsc_queue = options.has_test("mpsc_queue");
+    const bool test_mutex_contention = options.has_test("mutex_contention");
+    const bool test_read_mostly = options.has_test("read_mostly");
+    const bool test_lock_stat = options.has_test("lock_stat");
+    const bool test_parking_lot = options.has_test("parking_lot");
+    const bool test_blocking_pop = options.has_test("blocking_pop");
+    const bool test_flat_combining = options.has_test("flat_combining");
+    const bool test_sharded_counter = options.has_test("sharded_counter");
+    const bool test_thread_registry = options.has_test("thread_registry");
+    const bool test_threadlocal = options.has_test("threadlocal");
+    const bool test_parallel_sort = options.has_test("parallel_sort");
+    const bool test_topology = options.has_test("topology");
+    const bool test_shm_ipc = options.has_test("shm_ipc");
+    const bool test_multi_queue = options.has_test("multi_queue");
     
     // atomic_flag
     if(test_atomic_flag) {
@@ -94,7 +1030,7 @@ int main(int argc, const char * argv[]) {
         constexpr int num_iteration = 50;
         std::cout << "Running " << num_threads << " threads... (iteration:" << num_iteration << ")" << std::endl;
         
-        std::chrono::time_point<std::chrono::system_clock> time_begin, time_to;
+        std::chrono::time_point<std::chrono::steady_clock> time_begin, time_to;
         std::chrono::duration<double> elapsed;
         double sum_elapsed = 0;
         
@@ -102,7 +1038,7 @@ int main(int argc, const char * argv[]) {
             std::cout << "--------------------------------" << std::endl;
             std::cout << "- Iteration " << (i + 1) << std::endl;
             
-            time_begin = std::chrono::system_clock::now();
+            time_begin = std::chrono::steady_clock::now();
             
             std::thread ts[num_threads];
             for(int k = 0; k < num_threads; k++) {
@@ -112,7 +1048,7 @@ int main(int argc, const char * argv[]) {
                 ts[k].join();
             }
             
-            time_to = std::chrono::system_clock::now();
+            time_to = std::chrono::steady_clock::now();
             elapsed = (time_to - time_begin);
             std::cout << "Elapsed : " << elapsed.count() << " sec" << std::endl;
             sum_elapsed += elapsed.count();
@@ -248,7 +1184,7 @@ int main(int argc, const char * argv[]) {
                 pop_value_log[i] = new int[num_pop_iteration];
             }
             
-            std::chrono::time_point<std::chrono::system_clock> time_begin, time_to;
+            std::chrono::time_point<std::chrono::steady_clock> time_begin, time_to;
             std::chrono::duration<double> elapsed;
             std::thread ts_push[num_push_threads];
             std::thread ts_pop[num_pop_threads];
@@ -257,7 +1193,7 @@ int main(int argc, const char * argv[]) {
 #if SUPPORTS_PLATFORM_IMPLEMENTATION && 0
             /* platform lock-free stack (refernce) */
             std::cout << "(platform) Running " << (num_push_threads + num_pop_threads) << " threads... (iteration:push(" << num_push_iteration << "),pop(" << num_pop_iteration << "))" << std::endl;
-            time_begin = std::chrono::system_clock::now();
+            time_begin = std::chrono::steady_clock::now();
             
             for(int k = 0; k < num_push_threads; k++) {
                 ts_push[k] = std::thread(lock_free_stack_thread_push_main<platform_lf_stack_t>, &platform_stack, k, num_push_iteration, push_value_log[k]);
@@ -273,7 +1209,7 @@ int main(int argc, const char * argv[]) {
             }
             std::cout << "--------------------------------" << std::endl;
             
-            time_to = std::chrono::system_clock::now();
+            time_to = std::chrono::steady_clock::now();
             elapsed = (time_to - time_begin);
             std::cout << "Elapsed : " << elapsed.count() << " sec" << std::endl;
             
@@ -289,7 +1225,7 @@ int main(int argc, const char * argv[]) {
             
             /* lock-free stack using std::atomic */
             std::cout << "(std::atomic) Running " << (num_push_threads + num_pop_threads) << " threads... (iteration:push(" << num_push_iteration << "),pop(" << num_pop_iteration << "))" << std::endl;
-            time_begin = std::chrono::system_clock::now();
+            time_begin = std::chrono::steady_clock::now();
             
             for(int k = 0; k < num_push_threads; k++) {
                 ts_push[k] = std::thread(lock_free_stack_thread_push_main<lf_stack_t>, &stack, k, num_push_iteration, push_value_log[k]);
@@ -305,7 +1241,7 @@ int main(int argc, const char * argv[]) {
             }
             std::cout << "--------------------------------" << std::endl;
             
-            time_to = std::chrono::system_clock::now();
+            time_to = std::chrono::steady_clock::now();
             elapsed = (time_to - time_begin);
             std::cout << "Elapsed : " << elapsed.count() << " sec" << std::endl;
             
@@ -329,7 +1265,1068 @@ int main(int argc, const char * argv[]) {
             
             STAT_ALIVE_NODE_COUNT;
         }
+        
+        // multi threaded test (bounded stack, push-pop validation)
+        {
+            std::cout << "Multi-threaded bounded stack push and pop test..." << std::endl;
+            constexpr int num_push_threads = 8;
+            constexpr int num_pop_threads = 8;
+            constexpr int num_iteration = 1000000;
+            // small enough for pushers to hit the full stack
+            constexpr uint32_t capacity = 1024;
+            
+            bounded_lf_stack<int> bounded_stack(capacity);
+            std::vector<int> push_logs((size_t)num_push_threads * num_iteration), pop_logs((size_t)num_pop_threads * num_iteration);
+            int *push_value_log[num_push_threads];
+            int *pop_value_log[num_pop_threads];
+            std::vector<std::thread> ts;
+            
+            std::cout << "Running " << (num_push_threads + num_pop_threads) << " threads... (iteration:" << num_iteration << ", capacity:" << capacity << ")" << std::endl;
+            auto time_begin = std::chrono::steady_clock::now();
+            for(int k = 0; k < num_push_threads; k++) {
+                push_value_log[k] = &push_logs[(size_t)k * num_iteration];
+                ts.emplace_back([&bounded_stack, k, log = push_value_log[k]]() {
+                    for(int i = 0; i < num_iteration; i++) {
+                        int value = k * num_iteration + i;
+                        while(!bounded_stack.push(value))
+                            std::this_thread::yield();
+                        log[i] = value;
+                    }
+                });
+            }
+            for(int k = 0; k < num_pop_threads; k++) {
+                pop_value_log[k] = &pop_logs[(size_t)k * num_iteration];
+                ts.emplace_back([&bounded_stack, log = pop_value_log[k]]() {
+                    for(int i = 0; i < num_iteration; i++) {
+                        while(!bounded_stack.pop(log[i]))
+                            std::this_thread::yield();
+                    }
+                });
+            }
+            for(std::thread &t : ts)
+                t.join();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - time_begin;
+            std::cout << "--------------------------------" << std::endl;
+            std::cout << "Elapsed : " << elapsed.count() << " sec" << std::endl;
+            
+            // every node must be back in the free list
+            bool validation_flag = validate_push_pop(push_value_log, pop_value_log, num_push_threads, num_iteration, num_pop_threads, num_iteration);
+            int dummy_val = 0;
+            validation_flag &= !bounded_stack.pop(dummy_val);
+            uint32_t num_pushed = 0;
+            while(bounded_stack.push(0))
+                num_pushed++;
+            validation_flag &= num_pushed == capacity;
+            
+            // object pool hands out every slot once
+            bounded_object_pool<uint64_t> pool(capacity);
+            std::vector<uint64_t*> objects;
+            while(uint64_t *object = pool.allocate(objects.size()))
+                objects.push_back(object);
+            validation_flag &= objects.size() == capacity;
+            for(uint64_t *object : objects)
+                validation_flag &= *object == pool.get_index(object);
+            for(uint64_t *object : objects)
+                pool.free(object);
+            
+            std::cout << (validation_flag ? "Validation success!" : "Validation failed!") << std::endl;
+            std::cout << "Complete!" << std::endl << std::endl;
+        }
+    }
+    
+    if(test_hash_map) {
+        // single threaded test (enough inserts to go through several resizes)
+        {
+            std::cout << "Single-threaded hash map test..." << std::endl;
+            hash_map_t map(64);
+            constexpr int num_keys = 100000;
+            bool validation_flag = true;
+            for(int i = 0; i < num_keys; i++) {
+                validation_flag &= map.insert(i, i * 2);
+            }
+            validation_flag &= !map.insert(0, 0);
+            for(int i = 0; i < num_keys; i += 2) {
+                validation_flag &= map.erase(i);
+            }
+            for(int i = 0; i < num_keys; i++) {
+                int value = -1;
+                bool found = map.find(i, value);
+                validation_flag &= (i % 2 == 0) ? !found : (found && value == i * 2);
+            }
+            validation_flag &= map.size() == num_keys / 2;
+            
+            if(validation_flag)
+                std::cout << "Validation success!" << std::endl;
+            else
+                std::cout << "Validation failed!" << std::endl;
+            std::cout << "Bucket count : " << map.debug_bucket_count() << std::endl;
+            std::cout << "Complete!" << std::endl << std::endl;
+        }
+        
+        // multi threaded test (read/write mixes)
+        {
+            std::cout << "Multi-threaded hash map test..." << std::endl;
+            constexpr int num_total_ops = 4000000;
+            constexpr int read_percents[] = { 90, 50, 10 };
+            constexpr int thread_counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+            
+            for(int read_percent : read_percents) {
+                std::cout << "--------------------------------" << std::endl;
+                std::cout << "- Read " << read_percent << "% / Write " << (100 - read_percent) << "%" << std::endl;
+                for(int num_threads : thread_counts) {
+                    int num_iteration = num_total_ops / num_threads;
+                    double elapsed = run_hash_map_benchmark<hash_map_t>(num_threads, num_iteration, read_percent);
+                    double elapsed_locked = run_hash_map_benchmark<locked_hash_map_t>(num_threads, num_iteration, read_percent);
+                    std::cout << "threads:" << num_threads
+                              << " concurrent_hash_map:" << (num_total_ops / elapsed) << " ops/sec"
+                              << " unordered_map+spinlock:" << (num_total_ops / elapsed_locked) << " ops/sec" << std::endl;
+                }
+            }
+            std::cout << "--------------------------------" << std::endl;
+            std::cout << "Complete!" << std::endl << std::endl;
+        }
+    }
+    
+    if(test_skip_list) {
+        // single threaded test
+        {
+            std::cout << "Single-threaded skip list test..." << std::endl;
+            skip_list_t list;
+            bench_random random(1);
+            std::map<int, int> reference;
+            for(int i = 0; i < 100000; i++) {
+                int key = (int)(random.next() % 50000);
+                if(i % 3 == 2) {
+                    bool erased = list.erase(key);
+                    if(erased != (reference.erase(key) > 0))
+                        std::cout << "Erase mismatch! (key:" << key << ")" << std::endl;
+                }
+                else {
+                    bool inserted = list.insert(key, i);
+                    if(inserted != reference.emplace(key, i).second)
+                        std::cout << "Insert mismatch! (key:" << key << ")" << std::endl;
+                }
+            }
+            
+            bool validation_flag = true;
+            auto it = reference.begin();
+            list.for_each([&](const int &key, const int &value) {
+                if(it == reference.end() || it->first != key || it->second != value)
+                    validation_flag = false;
+                else
+                    ++it;
+            });
+            validation_flag &= it == reference.end();
+            
+            size_t num_in_range = 0;
+            list.for_each_range(1000, 2000, [&](const int &, const int &) { num_in_range++; });
+            validation_flag &= num_in_range == (size_t)std::distance(reference.lower_bound(1000), reference.lower_bound(2000));
+            
+            int key, value;
+            while(list.pop_min(key, value)) {
+                if(reference.empty() || reference.begin()->first != key) {
+                    validation_flag = false;
+                    break;
+                }
+                reference.erase(reference.begin());
+            }
+            validation_flag &= reference.empty();
+            
+            if(validation_flag)
+                std::cout << "Validation success!" << std::endl;
+            else
+                std::cout << "Validation failed!" << std::endl;
+            std::cout << "Complete!" << std::endl << std::endl;
+        }
+        
+        // multi threaded test (concurrent insert, then concurrent pop_min)
+        {
+            std::cout << "Multi-threaded skip list push and pop test..." << std::endl;
+            constexpr int num_threads = 16;
+            constexpr int num_iteration = 20000;
+            skip_list_t list;
+            std::vector<int> popped[num_threads];
+            std::thread ts[num_threads];
+            
+            for(int k = 0; k < num_threads; k++) {
+                ts[k] = std::thread([&list, k]() {
+                    for(int i = 0; i < num_iteration; i++)
+                        list.insert(i * num_threads + k, k);
+                });
+            }
+            for(int k = 0; k < num_threads; k++) {
+                ts[k].join();
+            }
+            for(int k = 0; k < num_threads; k++) {
+                ts[k] = std::thread([&list, &popped, k]() {
+                    int key, value;
+                    while(list.pop_min(key, value))
+                        popped[k].push_back(key);
+                });
+            }
+            for(int k = 0; k < num_threads; k++) {
+                ts[k].join();
+            }
+            
+            // every thread pops in increasing order, and all keys are popped once
+            bool validation_flag = true;
+            std::vector<int> all_popped;
+            for(int k = 0; k < num_threads; k++) {
+                validation_flag &= std::is_sorted(popped[k].begin(), popped[k].end());
+                all_popped.insert(all_popped.end(), popped[k].begin(), popped[k].end());
+            }
+            std::sort(all_popped.begin(), all_popped.end());
+            validation_flag &= all_popped.size() == (size_t)num_threads * num_iteration;
+            for(size_t i = 0; validation_flag && i < all_popped.size(); i++)
+                validation_flag &= all_popped[i] == (int)i;
+            
+            if(validation_flag)
+                std::cout << "Validation success!" << std::endl;
+            else
+                std::cout << "Validation failed!" << std::endl;
+            std::cout << "Complete!" << std::endl << std::endl;
+        }
+        
+        // ordered workloads
+        {
+            std::cout << "Multi-threaded skip list benchmark..." << std::endl;
+            constexpr int num_total_ops = 2000000;
+            constexpr int thread_counts[] = { 1, 4, 16, 64 };
+            
+            std::cout << "--------------------------------" << std::endl;
+            std::cout << "- Ordered map (find/insert/erase/range scan)" << std::endl;
+            for(int num_threads : thread_counts) {
+                int num_iteration = num_total_ops / num_threads;
+                double elapsed = run_ordered_map_benchmark<skip_list_t, false>(num_threads, num_iteration);
+                double elapsed_locked = run_ordered_map_benchmark<locked_ordered_map_t, false>(num_threads, num_iteration);
+                std::cout << "threads:" << num_threads
+                          << " lf_skip_list:" << (num_total_ops / elapsed) << " ops/sec"
+                          << " map+spinlock:" << (num_total_ops / elapsed_locked) << " ops/sec" << std::endl;
+            }
+            
+            std::cout << "--------------------------------" << std::endl;
+            std::cout << "- Priority queue (insert/pop_min)" << std::endl;
+            for(int num_threads : thread_counts) {
+                int num_iteration = num_total_ops / num_threads;
+                double elapsed = run_ordered_map_benchmark<skip_list_t, true>(num_threads, num_iteration);
+                double elapsed_locked = run_ordered_map_benchmark<locked_ordered_map_t, true>(num_threads, num_iteration);
+                std::cout << "threads:" << num_threads
+                          << " lf_skip_list:" << (num_total_ops / elapsed) << " ops/sec"
+                          << " map+spinlock:" << (num_total_ops / elapsed_locked) << " ops/sec" << std::endl;
+            }
+            std::cout << "--------------------------------" << std::endl;
+            std::cout << "Complete!" << std::endl << std::endl;
+        }
+    }
+    
+    if(test_mpsc_queue) {
+        // single threaded test
+        {
+            std::cout << "Single-threaded mpsc queue test..." << std::endl;
+            mailbox_queue_t queue;
+            mailbox_message_t messages[3];
+            
+            // push
+            for(int i = 0; i < 3; i++) {
+                messages[i].producer_index = 0;
+                messages[i].sequence = i + 1;
+                queue.push(&messages[i]);
+            }
+            
+            // pop
+            while(mailbox_message_t *message = queue.pop())
+                std::cout << message->sequence << std::endl;
+            
+            std::cout << "--------------------------------" << std::endl;
+            std::cout << "Complete!" << std::endl << std::endl;
+        }
+        
+        // many producers against one consumer
+        {
+            std::cout << "Multi-threaded mpsc queue test..." << std::endl;
+            constexpr int num_total_messages = 4000000;
+            constexpr int producer_counts[] = { 1, 3, 7, 15, 31, 63 };
+            
+            for(int num_producers : producer_counts) {
+                int num_iteration = num_total_messages / num_producers;
+                int num_messages = num_iteration * num_producers;
+                std::vector<mailbox_message_t> messages(num_messages);
+                std::vector<std::thread> ts(num_producers);
+                bool validation_flag = false;
+                
+                // intrusive mpsc queue
+                mailbox_queue_t queue;
+                auto time_begin = std::chrono::steady_clock::now();
+                std::thread consumer([&]() { validation_flag = mailbox_thread_consume_main(&queue, num_producers, num_messages); });
+                for(int k = 0; k < num_producers; k++) {
+                    ts[k] = std::thread(mailbox_thread_post_main, &queue, &messages[k * num_iteration], k, num_iteration);
+                }
+                for(int k = 0; k < num_producers; k++) {
+                    ts[k].join();
+                }
+                consumer.join();
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - time_begin;
+                
+                // lf_stack as a mailbox (reference)
+                lf_stack_t stack;
+                std::vector<int> pop_value_log(num_messages);
+                int *push_value_logs = new int[num_messages];
+                time_begin = std::chrono::steady_clock::now();
+                consumer = std::thread(lock_free_stack_thread_pop_main<lf_stack_t>, &stack, 0, num_messages, pop_value_log.data());
+                for(int k = 0; k < num_producers; k++) {
+                    ts[k] = std::thread(lock_free_stack_thread_push_main<lf_stack_t>, &stack, k, num_iteration, &push_value_logs[k * num_iteration]);
+                }
+                for(int k = 0; k < num_producers; k++) {
+                    ts[k].join();
+                }
+                consumer.join();
+                std::chrono::duration<double> elapsed_stack = std::chrono::steady_clock::now() - time_begin;
+                delete[] push_value_logs;
+                
+                std::cout << "producers:" << num_producers
+                          << " intrusive_mpsc_queue:" << (num_messages / elapsed.count()) << " msgs/sec"
+                          << " lf_stack:" << (num_messages / elapsed_stack.count()) << " msgs/sec"
+                          << (validation_flag ? " (in order)" : " (validation failed!)") << std::endl;
+            }
+            std::cout << "--------------------------------" << std::endl;
+            std::cout << "Complete!" << std::endl << std::endl;
+        }
+    }
+    
+    if(test_mutex_contention) {
+        std::cout << "Mutex contention test..." << std::endl;
+        constexpr int duration_ms = 200;
+        constexpr int thread_counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+        
+        for(int num_threads : thread_counts) {
+            std::cout << "--------------------------------" << std::endl;
+            print_mutex_benchmark<spinlock_mutex>("spinlock_mutex", num_threads, duration_ms);
+            print_mutex_benchmark<ticket_mutex>("ticket_mutex", num_threads, duration_ms);
+            print_mutex_benchmark<mcs_mutex>("mcs_mutex", num_threads, duration_ms);
+            print_mutex_benchmark<clh_mutex>("clh_mutex", num_threads, duration_ms);
+            print_mutex_benchmark<std::mutex>("std::mutex", num_threads, duration_ms);
+        }
+        std::cout << "--------------------------------" << std::endl;
+        std::cout << "Complete!" << std::endl << std::endl;
+    }
+    
+    if(test_read_mostly) {
+        std::cout << "Read-mostly lock test..." << std::endl;
+        constexpr int duration_ms = 200;
+        constexpr int thread_counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+        // 99% and 99.9% reads
+        constexpr int write_permilles[] = { 10, 1 };
+        
+        for(int write_permille : write_permilles) {
+            std::cout << "================================" << std::endl;
+            std::cout << "reads: " << (100.0 - write_permille / 10.0) << "%" << std::endl;
+            for(int num_threads : thread_counts) {
+                std::cout << "--------------------------------" << std::endl;
+                print_read_mostly_benchmark<locked_config_holder<spinlock_mutex>>("spinlock_mutex", num_threads, write_permille, duration_ms);
+                print_read_mostly_benchmark<rw_config_holder<rw_spinlock_mutex>>("rw_spinlock_mutex", num_threads, write_permille, duration_ms);
+                print_read_mostly_benchmark<rw_config_holder<std::shared_mutex>>("std::shared_mutex", num_threads, write_permille, duration_ms);
+                print_read_mostly_benchmark<rw_config_holder<asymmetric_rw_mutex>>("asymmetric_rw_mutex", num_threads, write_permille, duration_ms);
+                print_read_mostly_benchmark<seqlock_value<config_snapshot_t>>("seqlock_value", num_threads, write_permille, duration_ms);
+            }
+        }
+        
+        // read-side cost without writers (lock_shared + copy + unlock_shared)
+        std::cout << "================================" << std::endl;
+        std::cout << "asymmetric_rw_mutex uses membarrier: " << (asymmetric_rw_mutex().is_asymmetric() ? "yes" : "no (fallback)") << std::endl;
+        print_read_latency<locked_config_holder<spinlock_mutex>>("spinlock_mutex");
+        print_read_latency<rw_config_holder<rw_spinlock_mutex>>("rw_spinlock_mutex");
+        print_read_latency<rw_config_holder<std::shared_mutex>>("std::shared_mutex");
+        print_read_latency<rw_config_holder<asymmetric_rw_mutex>>("asymmetric_rw_mutex");
+        
+        // writers must never see a reader inside (and readers never a torn snapshot)
+        {
+            asymmetric_rw_mutex mutex;
+            std::atomic<int> readers_inside{0};
+            std::atomic<bool> stop{false};
+            std::atomic<bool> overlapped{false};
+            std::vector<std::thread> ts;
+            for(int k = 0; k < 4; k++) {
+                ts.emplace_back([&]() {
+                    while(!stop.load(std::memory_order_relaxed)) {
+                        scoped_read_lock<asymmetric_rw_mutex> lock{ &mutex };
+                        readers_inside.fetch_add(1, std::memory_order_relaxed);
+                        readers_inside.fetch_sub(1, std::memory_order_relaxed);
+                    }
+                });
+            }
+            for(int i = 0; i < 2000; i++) {
+                scoped_lock<asymmetric_rw_mutex> lock{ &mutex };
+                if(readers_inside.load(std::memory_order_relaxed) != 0)
+                    overlapped.store(true);
+            }
+            stop.store(true);
+            for(std::thread &t : ts)
+                t.join();
+            std::cout << (overlapped.load() ? "Validation failed!" : "Validation success!") << std::endl;
+        }
+        std::cout << "--------------------------------" << std::endl;
+        std::cout << "Complete!" << std::endl << std::endl;
+    }
+    
+    if(test_lock_stat) {
+        std::cout << "Lock contention profiling test..." << std::endl;
+#if USE_LOCK_STAT
+        constexpr int num_threads = 4;
+        global_mutex.set_lock_name("global_mutex");
+        
+        std::vector<std::thread> ts(num_threads);
+        for(int k = 0; k < num_threads; k++) {
+            ts[k] = std::thread(atomic_flag_thread_main);
+        }
+        for(int k = 0; k < num_threads; k++) {
+            ts[k].join();
+        }
+        run_hash_map_benchmark<hash_map_t>(num_threads, 100000, 90);
+        
+        global_lock_stat.print(std::cout, 5);
+#else
+        std::cout << "Build with USE_LOCK_STAT=1 to collect lock statistics." << std::endl;
+#endif
+        std::cout << "Complete!" << std::endl << std::endl;
+    }
+    
+    if(test_parking_lot) {
+        std::cout << "Parking lot test..." << std::endl;
+        constexpr int num_round_trips = 100000;
+        constexpr int waiter_counts[] = { 1, 4, 16, 64 };
+        
+        std::cout << "--------------------------------" << std::endl;
+        std::cout << "sizeof parking_condition:" << sizeof(parking_condition)
+                  << " parking_event:" << sizeof(parking_event)
+                  << " parking_semaphore:" << sizeof(parking_semaphore)
+                  << " std::condition_variable:" << sizeof(std::condition_variable) << std::endl;
+        
+        std::cout << "--------------------------------" << std::endl;
+        double elapsed = run_condition_ping_pong<spinlock_mutex, parking_condition>(num_round_trips);
+        double elapsed_std = run_condition_ping_pong<std::mutex, std_condition_adapter>(num_round_trips);
+        std::cout << "condition ping-pong: parking_condition " << (elapsed / num_round_trips * 1e9) << " ns/round trip,"
+                  << " std::condition_variable " << (elapsed_std / num_round_trips * 1e9) << " ns/round trip" << std::endl;
+        
+        elapsed = run_semaphore_ping_pong<parking_semaphore>(num_round_trips);
+        elapsed_std = run_semaphore_ping_pong<std_semaphore>(num_round_trips);
+        std::cout << "semaphore ping-pong: parking_semaphore " << (elapsed / num_round_trips * 1e9) << " ns/round trip,"
+                  << " std_semaphore " << (elapsed_std / num_round_trips * 1e9) << " ns/round trip" << std::endl;
+        
+        for(int num_waiters : waiter_counts) {
+            parking_event event;
+            elapsed = run_broadcast_latency(num_waiters, [&]() { event.wait(); }, [&]() { event.set(); });
+            
+            std::mutex mutex;
+            std::condition_variable condition;
+            bool signaled = false;
+            elapsed_std = run_broadcast_latency(num_waiters, [&]() {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [&]() { return signaled; });
+            }, [&]() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    signaled = true;
+                }
+                condition.notify_all();
+            });
+            std::cout << "waiters:" << num_waiters << " broadcast wake-up: parking_event " << (elapsed * 1e6) << " us,"
+                      << " std::condition_variable " << (elapsed_std * 1e6) << " us" << std::endl;
+        }
+        
+        // timed waits must expire, a set event must not block
+        std::cout << "--------------------------------" << std::endl;
+        parking_semaphore semaphore;
+        parking_event event;
+        bool validation_flag = !semaphore.acquire_for(1000000) && !event.wait_for(1000000);
+        event.set();
+        semaphore.release();
+        validation_flag &= event.wait_for(0) && semaphore.acquire_for(0) && !semaphore.try_acquire();
+        std::cout << (validation_flag ? "Validation success!" : "Validation failed!") << std::endl;
+        std::cout << "Complete!" << std::endl << std::endl;
+    }
+    
+    if(test_blocking_pop) {
+        std::cout << "Blocking pop test..." << std::endl;
+        constexpr int num_producers = 2;
+        constexpr int num_messages = 1000;
+        constexpr int interval_us = 200;
+        constexpr int consumer_counts[] = { 1, 2, 4 };
+        
+        for(int num_consumers : consumer_counts) {
+            std::cout << "--------------------------------" << std::endl;
+            wake_latency_result spin = run_wake_latency_benchmark<lf_stack<int64_t>, false>(num_producers, num_consumers, num_messages, interval_us);
+            wake_latency_result blocking = run_wake_latency_benchmark<lf_blocking_stack<int64_t>, true>(num_producers, num_consumers, num_messages, interval_us);
+            std::cout << "consumers:" << num_consumers << " spin pop: cpu " << spin.cpu_time << " sec,"
+                      << " latency mean " << spin.mean_latency_us << " us, max " << spin.max_latency_us << " us"
+                      << (spin.validated ? "" : " (validation failed!)") << std::endl;
+            std::cout << "consumers:" << num_consumers << " pop_wait: cpu " << blocking.cpu_time << " sec,"
+                      << " latency mean " << blocking.mean_latency_us << " us, max " << blocking.max_latency_us << " us"
+                      << (blocking.validated ? "" : " (validation failed!)") << std::endl;
+        }
+        
+        // pop_wait_for must time out on an empty stack
+        std::cout << "--------------------------------" << std::endl;
+        lf_blocking_stack<int> stack;
+        int value = 0;
+        bool validation_flag = !stack.pop_wait_for(value, 1000000);
+        stack.push(7);
+        validation_flag &= stack.pop_wait_for(value, 1000000) && value == 7;
+        std::cout << (validation_flag ? "Validation success!" : "Validation failed!") << std::endl;
+        std::cout << "Complete!" << std::endl << std::endl;
+    }
+    
+    if(test_flat_combining) {
+        std::cout << "Flat combining test..." << std::endl;
+        constexpr int duration_ms = 200;
+        constexpr int thread_counts[] = { 1, 4, 16, 32, 64 };
+        
+        for(int num_threads : thread_counts) {
+            std::cout << "--------------------------------" << std::endl;
+            
+            // shared counter (atomic_flag_thread_main pattern)
+            {
+                spinlock_mutex mutex;
+                uint64_t locked_counter = 0;
+                double locked_ops = run_throughput_benchmark(num_threads, duration_ms, [&](bench_random&) {
+                    scoped_lock<spinlock_mutex> lock{ &mutex };
+                    locked_counter++;
+                });
+                flat_combining<uint64_t> counter(0);
+                double combining_ops = run_throughput_benchmark(num_threads, duration_ms, [&](bench_random&) {
+                    counter.apply([](uint64_t &value) { value++; });
+                });
+                std::cout << "threads:" << num_threads << " counter: spinlock_mutex " << locked_ops << " ops/sec,"
+                          << " flat_combining " << combining_ops << " ops/sec" << std::endl;
+            }
+            
+            // stack (push, then pop)
+            {
+                lf_stack<int> stack;
+                double lf_ops = run_throughput_benchmark(num_threads, duration_ms, [&](bench_random &random) {
+                    int value = (int)random.next();
+                    stack.push(value);
+                    stack.pop(value);
+                });
+                spinlock_mutex mutex;
+                std::vector<int> locked_stack;
+                double locked_ops = run_throughput_benchmark(num_threads, duration_ms, [&](bench_random &random) {
+                    int value = (int)random.next();
+                    {
+                        scoped_lock<spinlock_mutex> lock{ &mutex };
+                        locked_stack.push_back(value);
+                    }
+                    {
+                        scoped_lock<spinlock_mutex> lock{ &mutex };
+                        locked_stack.pop_back();
+                    }
+                });
+                flat_combining<std::vector<int>> combining_stack;
+                double combining_ops = run_throughput_benchmark(num_threads, duration_ms, [&](bench_random &random) {
+                    int value = (int)random.next();
+                    combining_stack.apply([value](std::vector<int> &v) { v.push_back(value); });
+                    bench_sink.fetch_add(combining_stack.apply([](std::vector<int> &v) { int top = v.back(); v.pop_back(); return top; }), std::memory_order_relaxed);
+                });
+                std::cout << "threads:" << num_threads << " stack: lf_stack " << lf_ops << " ops/sec,"
+                          << " spinlock_mutex " << locked_ops << " ops/sec,"
+                          << " flat_combining " << combining_ops << " ops/sec" << std::endl;
+            }
+            
+            // priority heap (push, then pop the top)
+            {
+                spinlock_mutex mutex;
+                std::priority_queue<int> locked_heap;
+                double locked_ops = run_throughput_benchmark(num_threads, duration_ms, [&](bench_random &random) {
+                    int value = (int)(random.next() & 0xFFFFFF);
+                    scoped_lock<spinlock_mutex> lock{ &mutex };
+                    locked_heap.push(value);
+                    bench_sink.fetch_add(locked_heap.top(), std::memory_order_relaxed);
+                    locked_heap.pop();
+                });
+                flat_combining<std::priority_queue<int>> combining_heap;
+                double combining_ops = run_throughput_benchmark(num_threads, duration_ms, [&](bench_random &random) {
+                    int value = (int)(random.next() & 0xFFFFFF);
+                    int top = combining_heap.apply([value](std::priority_queue<int> &heap) {
+                        heap.push(value);
+                        int top = heap.top();
+                        heap.pop();
+                        return top;
+                    });
+                    bench_sink.fetch_add(top, std::memory_order_relaxed);
+                });
+                std::cout << "threads:" << num_threads << " priority heap: spinlock_mutex " << locked_ops << " ops/sec,"
+                          << " flat_combining " << combining_ops << " ops/sec" << std::endl;
+            }
+        }
+        
+        // every increment must be applied exactly once
+        std::cout << "--------------------------------" << std::endl;
+        {
+            constexpr int num_threads = 16;
+            constexpr int num_iteration = 100000;
+            flat_combining<uint64_t> counter(0);
+            std::vector<std::thread> ts(num_threads);
+            for(int k = 0; k < num_threads; k++) {
+                ts[k] = std::thread([&counter]() {
+                    for(int i = 0; i < num_iteration; i++)
+                        counter.apply([](uint64_t &value) { value++; });
+                });
+            }
+            for(int k = 0; k < num_threads; k++) {
+                ts[k].join();
+            }
+            bool validation_flag = counter.debug_object() == (uint64_t)num_threads * num_iteration;
+            std::cout << (validation_flag ? "Validation success!" : "Validation failed!") << std::endl;
+        }
+        std::cout << "Complete!" << std::endl << std::endl;
+    }
+    
+    if(test_sharded_counter) {
+        std::cout << "Sharded counter test..." << std::endl;
+        constexpr int duration_ms = 200;
+        constexpr int thread_counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+        
+        for(int num_threads : thread_counts) {
+            std::atomic<uint64_t> atomic_counter{0};
+            double atomic_ops = run_throughput_benchmark(num_threads, duration_ms, [&](bench_random&) {
+                atomic_counter.fetch_add(1, std::memory_order_relaxed);
+            });
+            sharded_counter counter;
+            double sharded_ops = run_throughput_benchmark(num_threads, duration_ms, [&](bench_random&) {
+                counter.add(1);
+            });
+            sharded_histogram histogram;
+            double histogram_ops = run_throughput_benchmark(num_threads, duration_ms, [&](bench_random &random) {
+                histogram.record(random.next() & 0xFFFF);
+            });
+            std::cout << "threads:" << num_threads << " std::atomic fetch_add " << atomic_ops << " ops/sec,"
+                      << " sharded_counter " << sharded_ops << " ops/sec,"
+                      << " sharded_histogram " << histogram_ops << " ops/sec" << std::endl;
+        }
+        
+        // aggregates must match once the writers are done
+        std::cout << "--------------------------------" << std::endl;
+        {
+            constexpr int num_threads = 16;
+            constexpr int num_iteration = 100000;
+            sharded_counter counter;
+            sharded_gauge gauge;
+            sharded_histogram histogram;
+            std::vector<std::thread> ts(num_threads);
+            for(int k = 0; k < num_threads; k++) {
+                ts[k] = std::thread([&]() {
+                    for(int i = 0; i < num_iteration; i++) {
+                        counter.add(1);
+                        gauge.increment();
+                        histogram.record(i);
+                        gauge.decrement();
+                    }
+                });
+            }
+            for(int k = 0; k < num_threads; k++) {
+                ts[k].join();
+            }
+            histogram_snapshot snapshot = histogram.snapshot();
+            std::cout << "histogram: count " << snapshot.count << ", mean " << snapshot.mean()
+                      << ", p50 <= " << snapshot.percentile(0.5) << ", p99 <= " << snapshot.percentile(0.99) << std::endl;
+            bool validation_flag = counter.read() == (int64_t)num_threads * num_iteration && gauge.read() == 0 &&
+                                   snapshot.count == (uint64_t)num_threads * num_iteration &&
+                                   snapshot.sum == (uint64_t)num_threads * ((uint64_t)num_iteration * (num_iteration - 1) / 2);
+            std::cout << (validation_flag ? "Validation success!" : "Validation failed!") << std::endl;
+        }
+        std::cout << "Complete!" << std::endl << std::endl;
+    }
+    
+    if(test_thread_registry) {
+        std::cout << "Thread registry test..." << std::endl;
+        constexpr int num_waves = 16;
+        constexpr int num_threads = 32;
+        
+        std::atomic<int> num_exit_callbacks{0};
+        std::atomic<int> num_local_exit_callbacks{0};
+        uint64_t handle = global_thread_registry.add_exit_callback([](threadlocal_thread_id, void *context) {
+            ((std::atomic<int>*)context)->fetch_add(1);
+        }, &num_exit_callbacks);
+        
+        // waves of short-lived threads must keep reusing the same dense ids
+        bool validation_flag = true;
+        uint32_t main_thread_id = threadlocal_get_thread_id();
+        auto time_begin = std::chrono::steady_clock::now();
+        for(int wave = 0; wave < num_waves; wave++) {
+            std::vector<threadlocal_thread_id> ids(num_threads);
+            std::atomic<int> num_started{0};
+            std::atomic<bool> release{false};
+            std::vector<std::thread> ts(num_threads);
+            for(int k = 0; k < num_threads; k++) {
+                ts[k] = std::thread([&, k]() {
+                    ids[k] = threadlocal_get_thread_id();
+                    global_thread_registry.at_thread_exit([](threadlocal_thread_id, void *context) {
+                        ((std::atomic<int>*)context)->fetch_add(1);
+                    }, &num_local_exit_callbacks);
+                    num_started.fetch_add(1);
+                    while(!release.load())
+                        std::this_thread::yield();
+                });
+            }
+            while(num_started.load() < num_threads)
+                std::this_thread::yield();
+            validation_flag &= global_thread_registry.get_live_threads().size() == (size_t)num_threads + 1;
+            release.store(true);
+            for(int k = 0; k < num_threads; k++) {
+                ts[k].join();
+            }
+            
+            std::sort(ids.begin(), ids.end());
+            validation_flag &= std::unique(ids.begin(), ids.end()) == ids.end();
+            for(threadlocal_thread_id id : ids)
+                validation_flag &= id != main_thread_id && id <= (threadlocal_thread_id)num_threads;
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - time_begin;
+        global_thread_registry.remove_exit_callback(handle);
+        
+        std::cout << "threads:" << num_waves * num_threads << " id capacity:" << global_thread_registry.get_id_capacity()
+                  << " live:" << global_thread_registry.get_live_thread_count()
+                  << " exit callbacks:" << num_exit_callbacks.load() << "/" << num_local_exit_callbacks.load()
+                  << " (" << elapsed.count() << " sec)" << std::endl;
+        validation_flag &= num_exit_callbacks.load() == num_waves * num_threads && num_local_exit_callbacks.load() == num_waves * num_threads;
+        validation_flag &= global_thread_registry.get_live_thread_count() == 1;
+        std::cout << (validation_flag ? "Validation success!" : "Validation failed!") << std::endl;
+        std::cout << "Complete!" << std::endl << std::endl;
     }
     
+    if(test_threadlocal) {
+        std::cout << "Enumerable threadlocal test..." << std::endl;
+        constexpr int duration_ms = 200;
+        constexpr int thread_counts[] = { 1, 4, 16, 64 };
+        
+        for(int num_threads : thread_counts) {
+            spinlock_mutex mutex;
+            request_stat_t locked_stat;
+            double locked_ops = run_throughput_benchmark(num_threads, duration_ms, [&](bench_random &random) {
+                uint64_t latency = random.next() & 0xFFF;
+                scoped_lock<spinlock_mutex> lock{ &mutex };
+                locked_stat.add(latency);
+            });
+            threadlocal<request_stat_t> local_stat;
+            double local_ops = run_throughput_benchmark(num_threads, duration_ms, [&](bench_random &random) {
+                local_stat.local().add(random.next() & 0xFFF);
+            });
+            request_stat_t combined = local_stat.combine(request_stat_t::merge);
+            std::cout << "threads:" << num_threads << " stat collection: spinlock_mutex " << locked_ops << " ops/sec,"
+                      << " threadlocal " << local_ops << " ops/sec (combined count " << combined.count << ")" << std::endl;
+        }
+        
+        // instances of exited threads must survive until combined
+        std::cout << "--------------------------------" << std::endl;
+        {
+            constexpr int num_waves = 8;
+            constexpr int num_threads = 16;
+            constexpr int num_iteration = 10000;
+            threadlocal<uint64_t> counter(0);
+            for(int wave = 0; wave < num_waves; wave++) {
+                std::vector<std::thread> ts(num_threads);
+                for(int k = 0; k < num_threads; k++) {
+                    ts[k] = std::thread([&counter]() {
+                        for(int i = 0; i < num_iteration; i++)
+                            counter.local()++;
+                    });
+                }
+                for(int k = 0; k < num_threads; k++) {
+                    ts[k].join();
+                }
+            }
+            size_t num_instances = 0;
+            counter.for_each([&](uint64_t&) { num_instances++; });
+            uint64_t total = counter.combine([](uint64_t a, uint64_t b) { return a + b; });
+            std::cout << "instances:" << num_instances << " total:" << total << std::endl;
+            bool validation_flag = total == (uint64_t)num_waves * num_threads * num_iteration && num_instances == (size_t)num_waves * num_threads;
+            std::cout << (validation_flag ? "Validation success!" : "Validation failed!") << std::endl;
+        }
+        std::cout << "Complete!" << std::endl << std::endl;
+    }
+    
+    if(test_parallel_sort) {
+        std::cout << "Parallel sort test..." << std::endl;
+        std::cout << "thread pool workers:" << get_global_thread_pool().get_worker_count() << std::endl;
+        constexpr size_t counts[] = { 1 << 16, 1 << 20, 1 << 24 };
+        bool validation_flag = true;
+        
+        for(size_t count : counts) {
+            std::vector<int> values(count);
+            bench_random random(count);
+            for(size_t i = 0; i < count; i++)
+                values[i] = (int)random.next();
+            std::vector<int> expected = values;
+            
+            auto time_begin = std::chrono::steady_clock::now();
+            std::sort(expected.begin(), expected.end());
+            std::chrono::duration<double> std_elapsed = std::chrono::steady_clock::now() - time_begin;
+            
+            time_begin = std::chrono::steady_clock::now();
+            parallel_radix_sort(values.data(), values.size());
+            std::chrono::duration<double> radix_elapsed = std::chrono::steady_clock::now() - time_begin;
+            
+            bool sorted = values == expected;
+            validation_flag &= sorted;
+            std::cout << "count:" << count << " std::sort " << std_elapsed.count() << "s, parallel_radix_sort " << radix_elapsed.count() << "s" << (sorted ? "" : " (mismatch)") << std::endl;
+        }
+        
+        // parallel_reduce / parallel_for against a sequential sum
+        {
+            constexpr size_t count = 1 << 24;
+            std::vector<uint64_t> values(count);
+            parallel_for(0, count, [&](size_t i) { values[i] = i * 2654435761ull; });
+            uint64_t expected = 0;
+            for(size_t i = 0; i < count; i++)
+                expected += values[i];
+            uint64_t total = parallel_reduce(0, count, (uint64_t)0, [&](size_t begin, size_t end) {
+                uint64_t sum = 0;
+                for(size_t i = begin; i < end; i++)
+                    sum += values[i];
+                return sum;
+            }, [](uint64_t a, uint64_t b) { return a + b; });
+            std::cout << "parallel_reduce sum:" << total << " expected:" << expected << std::endl;
+            validation_flag &= total == expected;
+        }
+        std::cout << (validation_flag ? "Validation success!" : "Validation failed!") << std::endl;
+        std::cout << "Complete!" << std::endl << std::endl;
+    }
+    
+    if(test_topology) {
+        std::cout << "CPU topology test..." << std::endl;
+        const platform::platform_topology &topology = platform::platform_get_topology();
+        std::cout << "cpus:" << topology.cpus.size() << " physical cores:" << topology.num_physical_cores
+                  << " packages:" << topology.num_packages << " numa nodes:" << topology.num_numa_nodes
+                  << " cache line:" << topology.cache_line_size << " (compile-time " << PLATFORM_CACHE_LINE_SIZE << ")" << std::endl;
+        for(const platform::platform_cache_info &cache : topology.caches) {
+            std::cout << "L" << cache.level << cache.type << " " << (cache.size >> 10) << "KB line:" << cache.line_size
+                      << " shared by " << cache.num_shared_cpus << " cpus" << std::endl;
+        }
+        for(const platform::platform_cpu_info &info : topology.cpus) {
+            std::cout << "cpu" << info.cpu << " package:" << info.package << " core:" << info.core
+                      << " smt:" << info.smt_index << " node:" << info.numa_node << std::endl;
+        }
+        
+        // contended counter under each placement policy
+        std::cout << "--------------------------------" << std::endl;
+        constexpr int duration_ms = 200;
+        constexpr platform::platform_placement placements[] = {
+            platform::platform_placement::none,
+            platform::platform_placement::compact,
+            platform::platform_placement::scatter,
+            platform::platform_placement::physical_cores,
+        };
+        int num_threads = (int)topology.num_physical_cores;
+        bool validation_flag = true;
+        for(platform::platform_placement placement : placements) {
+            std::vector<uint32_t> cpus = platform::platform_get_placement(placement, num_threads);
+            validation_flag &= placement == platform::platform_placement::none ? cpus.empty() : cpus.size() == (size_t)num_threads;
+            benchmark_placement = placement;
+            spinlock_mutex mutex;
+            uint64_t counter = 0;
+            double ops = run_throughput_benchmark(num_threads, duration_ms, [&](bench_random&) {
+                scoped_lock<spinlock_mutex> lock{ &mutex };
+                counter++;
+            });
+            std::cout << "threads:" << num_threads << " placement:" << platform::platform_get_placement_name(placement) << " cpus:";
+            for(uint32_t cpu : cpus)
+                std::cout << " " << cpu;
+            std::cout << " spinlock_mutex counter " << ops << " ops/sec" << std::endl;
+        }
+        benchmark_placement = platform::platform_placement::none;
+        
+        // a single thread per physical core never shares a core
+        std::vector<uint32_t> cpus = platform::platform_get_placement(platform::platform_placement::physical_cores, topology.num_physical_cores);
+        std::vector<bool> used(topology.num_physical_cores, false);
+        for(uint32_t cpu : cpus) {
+            for(const platform::platform_cpu_info &info : topology.cpus) {
+                if(info.cpu == cpu) {
+                    validation_flag &= !used[info.core];
+                    used[info.core] = true;
+                }
+            }
+        }
+        std::cout << (validation_flag ? "Validation success!" : "Validation failed!") << std::endl;
+        std::cout << "Complete!" << std::endl << std::endl;
+    }
+    
+    if(test_multi_queue) {
+        std::cout << "MultiQueue test..." << std::endl;
+        bool validation_flag = true;
+        
+        // concurrent push and pop, every element must come out exactly once
+        {
+            constexpr int num_threads = 4;
+            constexpr int num_iteration = 250000;
+            multi_queue<uint32_t> queue(num_threads);
+            std::vector<std::vector<uint32_t>> popped(num_threads);
+            std::vector<std::thread> ts;
+            for(int k = 0; k < num_threads; k++) {
+                ts.emplace_back([&, k]() {
+                    bench_random random(k + 1);
+                    for(int i = 0; i < num_iteration; i++) {
+                        uint32_t value = (uint32_t)(k * num_iteration + i);
+                        queue.push(random.next() & 0xFFFF, value);
+                        uint64_t priority;
+                        if(i % 2 == 1 && queue.pop(priority, value))
+                            popped[k].push_back(value);
+                    }
+                });
+            }
+            for(std::thread &t : ts)
+                t.join();
+            std::vector<uint32_t> values;
+            for(std::vector<uint32_t> &log : popped)
+                values.insert(values.end(), log.begin(), log.end());
+            // the drain order is relaxed, but nothing may be lost
+            uint64_t priority;
+            uint32_t value;
+            while(queue.pop(priority, value))
+                values.push_back(value);
+            std::sort(values.begin(), values.end());
+            bool exact = values.size() == (size_t)num_threads * num_iteration;
+            for(size_t i = 0; exact && i < values.size(); i++)
+                exact = values[i] == i;
+            std::cout << "push/pop " << values.size() << " elements: " << (exact ? "every element once" : "mismatch") << " (empty:" << queue.empty() << ")" << std::endl;
+            validation_flag &= exact && queue.empty();
+            
+            // max_priority leaves later deadlines queued
+            queue.push(100, 1);
+            queue.push(200, 2);
+            validation_flag &= queue.pop(priority, value, 150) && value == 1;
+            validation_flag &= !queue.pop(priority, value, 150);
+            validation_flag &= queue.pop(priority, value) && value == 2;
+        }
+        
+        // rank error of pop() (c x P heaps, P = threads the queue is sized for)
+        std::cout << "--------------------------------" << std::endl;
+        for(uint32_t num_threads : { 1u, 4u, 16u, 64u }) {
+            multi_queue<uint32_t> queue(num_threads);
+            rank_error_result result = measure_rank_error(queue, 100000, 1000000);
+            std::cout << "heaps:" << queue.get_heap_count() << " rank error mean:" << result.mean << " p99:" << result.p99 << " max:" << result.max << std::endl;
+        }
+        {
+            locked_priority_queue<uint32_t> queue;
+            rank_error_result result = measure_rank_error(queue, 100000, 1000000);
+            std::cout << "locked_priority_queue rank error mean:" << result.mean << " p99:" << result.p99 << " max:" << result.max << std::endl;
+            validation_flag &= result.max == 0;
+        }
+        
+        // throughput (push + pop around 64K queued elements)
+        constexpr int duration_ms = 200;
+        constexpr int thread_counts[] = { 1, 2, 4, 8, 16 };
+        for(int num_threads : thread_counts) {
+            std::cout << "--------------------------------" << std::endl;
+            multi_queue<uint32_t> queue((uint32_t)num_threads);
+            locked_priority_queue<uint32_t> locked_queue;
+            bench_random random(num_threads);
+            for(int i = 0; i < 65536; i++) {
+                uint64_t priority = random.next() & 0xFFFFF;
+                queue.push(priority, i);
+                locked_queue.push(priority, i);
+            }
+            double multi_ops = run_throughput_benchmark(num_threads, duration_ms, [&](bench_random &r) {
+                uint64_t priority = r.next() & 0xFFFFF;
+                uint32_t value = 0;
+                queue.push(priority, value);
+                queue.pop(priority, value);
+            });
+            double locked_ops = run_throughput_benchmark(num_threads, duration_ms, [&](bench_random &r) {
+                uint64_t priority = r.next() & 0xFFFFF;
+                uint32_t value = 0;
+                locked_queue.push(priority, value);
+                locked_queue.pop(priority, value);
+            });
+            std::cout << "threads:" << num_threads << " multi_queue " << multi_ops << " ops/sec, locked_priority_queue " << locked_ops << " ops/sec" << std::endl;
+        }
+        std::cout << (validation_flag ? "Validation success!" : "Validation failed!") << std::endl;
+        std::cout << "Complete!" << std::endl << std::endl;
+    }
+    
+    if(test_shm_ipc) {
+        std::cout << "Shared memory IPC test..." << std::endl;
+#if SUPPORTS_PLATFORM_SHARED_MEMORY
+        constexpr uint64_t num_stream_messages = 1000000;
+        constexpr uint64_t num_ping_pong_messages = 100000;
+        bool validation_flag = true;
+        
+        std::vector<ipc_result> results;
+        results.push_back(ipc_benchmark::run_shm_stream(num_stream_messages));
+        results.push_back(ipc_benchmark::run_socket_stream(num_stream_messages));
+        results.push_back(ipc_benchmark::run_shm_ping_pong(num_ping_pong_messages));
+        results.push_back(ipc_benchmark::run_socket_ping_pong(num_ping_pong_messages));
+        for(const ipc_result &result : results) {
+            ipc_benchmark::print_row(std::cout, result);
+            validation_flag &= result.validated;
+        }
+        
+        // peers dying in the middle of a ring operation
+        std::cout << "--------------------------------" << std::endl;
+        bool producer_crash = ipc_benchmark::run_producer_crash();
+        bool consumer_crash = ipc_benchmark::run_consumer_crash();
+        uint32_t num_recovered = 0;
+        bool kill_producer = ipc_benchmark::run_kill_producer(20, num_recovered);
+        std::cout << "producer crash after claim : " << (producer_crash ? "recovered" : "failed") << std::endl;
+        std::cout << "consumer crash after claim : " << (consumer_crash ? "recovered" : "failed") << std::endl;
+        std::cout << "SIGKILL producer x20 : " << (kill_producer ? "recovered" : "failed") << " (stuck slots repaired:" << num_recovered << ")" << std::endl;
+        validation_flag &= producer_crash && consumer_crash && kill_producer;
+        std::cout << (validation_flag ? "Validation success!" : "Validation failed!") << std::endl;
+#else
+        std::cout << "shared memory is not supported on this platform" << std::endl;
+#endif
+        std::cout << "Complete!" << std::endl << std::endl;
+    }
+    
+    if(!options.benchmarks.empty()) {
+        std::vector<benchmark_result> results = runner.run(options, options.format == "text" && options.output_path.empty() ? nullptr : &std::cerr);
+        if(options.output_path.empty()) {
+            benchmark_runner::print(std::cout, results, options.format);
+        }
+        else {
+            std::ofstream file(options.output_path);
+            if(!file) {
+                std::cerr << "can't open " << options.output_path << std::endl;
+                return 1;
+            }
+            benchmark_runner::print(file, results, options.format);
+        }
+    }
+    
+    if(!options.allocator_scenarios.empty()) {
+        // every malloc run before the first memory_pool run, the pool keeps its pages
+        // and would inflate the malloc baseline. Later pool runs reuse those pages,
+        // so their rss growth only counts pages beyond what earlier runs left.
+        std::vector<allocator_result> results;
+        std::ostream &progress = options.format == "text" && options.output_path.empty() ? std::cout : std::cerr;
+        auto run_scenarios = [&](auto &&benchmark) {
+            for(const std::string &scenario : allocator_benchmark<system_allocator>::get_scenarios()) {
+                if(!benchmark_runner::matches(scenario, options.allocator_scenarios))
+                    continue;
+                for(int num_threads : options.thread_counts) {
+                    results.push_back(benchmark.run(scenario, num_threads, options.duration_ms));
+                    benchmark.print_text_row(progress, results.back());
+                }
+            }
+        };
+        run_scenarios(allocator_benchmark<system_allocator>());
+        run_scenarios(allocator_benchmark<pool_allocator>());
+        if(options.output_path.empty()) {
+            if(options.format != "text")
+                allocator_benchmark<system_allocator>::print(std::cout, results, options.format);
+        }
+        else {
+            std::ofstream file(options.output_path);
+            allocator_benchmark<system_allocator>::print(file, results, options.format);
+        }
+    }
+    
+#if USE_TRACE
+    if(!options.trace_path.empty()) {
+        global_tracer.stop();
+        std::string json_path = options.trace_path + ".json";
+        tracer::convert_to_chrome_json(options.trace_path.c_str(), json_path.c_str());
+        std::cout << "Trace written to " << options.trace_path << " and " << json_path << " (dropped events:" << global_tracer.get_dropped_count() << ")" << std::endl;
+    }
+#endif
+    
     return 0;
 }
@@ -12,4 +12,12 @@
 #define USE_MEMORY_POOL 0
 #endif
 
+#ifndef USE_LOCK_STAT
+#define USE_LOCK_STAT 0
+#endif
+
+#ifndef USE_TRACE
+#define USE_TRACE 0
+#endif
+
 #endif /* Option_h */
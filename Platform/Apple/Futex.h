@@ -0,0 +1,43 @@
+//
+//  Futex.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include "../PlatformDefine.h"
+#include "../PlatformCommon.h"
+
+// private ulock interface of Darwin (used by libc++ for std::atomic::wait too)
+extern "C" int __ulock_wait(uint32_t operation, void *addr, uint64_t value, uint32_t timeout_us);
+extern "C" int __ulock_wake(uint32_t operation, void *addr, uint64_t wake_value);
+
+NAMESPACE_PLATFORM_BEGIN
+
+constexpr uint32_t PLATFORM_UL_COMPARE_AND_WAIT = 1;
+constexpr uint32_t PLATFORM_ULF_WAKE_ALL = 0x00000100;
+constexpr uint32_t PLATFORM_ULF_NO_ERRNO = 0x01000000;
+
+// blocks while *address == expected, returns false on timeout (timeout_ns < 0 : infinite)
+inline bool platform_futex_wait(std::atomic<uint32_t> *address, uint32_t expected, int64_t timeout_ns = -1) {
+    uint32_t timeout_us = timeout_ns < 0 ? 0 : (uint32_t)((timeout_ns + 999) / 1000);
+    if(timeout_ns >= 0 && timeout_us == 0)
+        timeout_us = 1;
+    int ret = __ulock_wait(PLATFORM_UL_COMPARE_AND_WAIT | PLATFORM_ULF_NO_ERRNO, (void*)address, expected, timeout_us);
+    return ret != -ETIMEDOUT;
+}
+
+inline void platform_futex_wake_one(std::atomic<uint32_t> *address) {
+    __ulock_wake(PLATFORM_UL_COMPARE_AND_WAIT | PLATFORM_ULF_NO_ERRNO, (void*)address, 0);
+}
+
+inline void platform_futex_wake_all(std::atomic<uint32_t> *address) {
+    __ulock_wake(PLATFORM_UL_COMPARE_AND_WAIT | PLATFORM_ULF_WAKE_ALL | PLATFORM_ULF_NO_ERRNO, (void*)address, 0);
+}
+
+NAMESPACE_PLATFORM_END
@@ -0,0 +1,43 @@
+//
+//  Futex.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "../PlatformDefine.h"
+#include "../PlatformCommon.h"
+
+NAMESPACE_PLATFORM_BEGIN
+
+// blocks while *address == expected, returns false on timeout (timeout_ns < 0 : infinite)
+inline bool platform_futex_wait(std::atomic<uint32_t> *address, uint32_t expected, int64_t timeout_ns = -1) {
+    struct timespec timeout;
+    struct timespec *timeout_ptr = nullptr;
+    if(timeout_ns >= 0) {
+        timeout.tv_sec = (time_t)(timeout_ns / 1000000000);
+        timeout.tv_nsec = (long)(timeout_ns % 1000000000);
+        timeout_ptr = &timeout;
+    }
+    long ret = syscall(SYS_futex, (uint32_t*)address, FUTEX_WAIT_PRIVATE, expected, timeout_ptr, nullptr, 0);
+    return !(ret == -1 && errno == ETIMEDOUT);
+}
+
+inline void platform_futex_wake_one(std::atomic<uint32_t> *address) {
+    syscall(SYS_futex, (uint32_t*)address, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+inline void platform_futex_wake_all(std::atomic<uint32_t> *address) {
+    syscall(SYS_futex, (uint32_t*)address, FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
+}
+
+NAMESPACE_PLATFORM_END
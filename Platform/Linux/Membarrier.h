@@ -0,0 +1,42 @@
+//
+//  Membarrier.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#pragma once
+
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "../PlatformDefine.h"
+#include "../PlatformCommon.h"
+
+NAMESPACE_PLATFORM_BEGIN
+
+// queries and registers MEMBARRIER_CMD_PRIVATE_EXPEDITED once per process
+inline bool platform_membarrier_is_supported() {
+    static const bool supported = []() {
+#ifdef SYS_membarrier
+        long commands = syscall(SYS_membarrier, MEMBARRIER_CMD_QUERY, 0);
+        if(commands < 0 || (commands & MEMBARRIER_CMD_PRIVATE_EXPEDITED) == 0)
+            return false;
+        return syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0) == 0;
+#else
+        return false;
+#endif
+    }();
+    return supported;
+}
+
+// every running thread of the process executes a full barrier before this returns
+inline bool platform_membarrier() {
+#ifdef SYS_membarrier
+    return syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0) == 0;
+#else
+    return false;
+#endif
+}
+
+NAMESPACE_PLATFORM_END
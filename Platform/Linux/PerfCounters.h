@@ -0,0 +1,159 @@
+//
+//  PerfCounters.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "../PlatformDefine.h"
+#include "../PlatformCommon.h"
+
+// platform_perf_event and platform_perf_sample are declared by PlatformPerfCounters.h
+
+NAMESPACE_PLATFORM_BEGIN
+
+// Hardware counter group of the calling thread (perf_event_open)
+//
+// Events are opened as one group so they are scheduled together. An event
+// the PMU or perf_event_paranoid refuses is left out (its sample stays
+// invalid); open() fails only when none can be opened. User space only, so
+// paranoid level 2 is enough.
+class platform_perf_counters {
+public:
+    platform_perf_counters() {
+        for(uint32_t i = 0; i < PLATFORM_PERF_EVENT_COUNT; i++)
+            fds[i] = -1;
+    }
+
+    ~platform_perf_counters() {
+        close();
+    }
+
+    platform_perf_counters(const platform_perf_counters&) = delete;
+    platform_perf_counters& operator=(const platform_perf_counters&) = delete;
+
+public:
+    // must be called from the measured thread
+    bool open() {
+        close();
+        static const struct { uint32_t type; uint64_t config; } events[PLATFORM_PERF_EVENT_COUNT] = {
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+            { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+        };
+        int first_errno = 0;
+        for(uint32_t i = 0; i < PLATFORM_PERF_EVENT_COUNT; i++) {
+            struct perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = events[i].type;
+            attr.config = events[i].config;
+            attr.disabled = leader_fd < 0 ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, leader_fd, 0);
+            if(fd < 0) {
+                if(first_errno == 0)
+                    first_errno = errno;
+                continue;
+            }
+            fds[i] = fd;
+            ioctl(fd, PERF_EVENT_IOC_ID, &ids[i]);
+            if(leader_fd < 0)
+                leader_fd = fd;
+        }
+        if(leader_fd < 0) {
+            set_error(first_errno);
+            return false;
+        }
+        error = nullptr;
+        return true;
+    }
+
+    void close() {
+        for(uint32_t i = 0; i < PLATFORM_PERF_EVENT_COUNT; i++) {
+            if(fds[i] >= 0)
+                ::close(fds[i]);
+            fds[i] = -1;
+        }
+        leader_fd = -1;
+    }
+
+    bool is_open() const { return leader_fd >= 0; }
+
+    // reason of the last failed open()
+    const char *get_error() const { return error != nullptr ? error : ""; }
+
+    // resets and enables the group
+    void start() {
+        if(leader_fd < 0)
+            return;
+        ioctl(leader_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    void stop() {
+        if(leader_fd >= 0)
+            ioctl(leader_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    platform_perf_sample read() const {
+        platform_perf_sample sample;
+        if(leader_fd < 0)
+            return sample;
+        // nr, time_enabled, time_running, then { value, id } per event
+        uint64_t buffer[3 + 2 * PLATFORM_PERF_EVENT_COUNT];
+        ssize_t size = ::read(leader_fd, buffer, sizeof(buffer));
+        if(size < (ssize_t)(3 * sizeof(uint64_t)))
+            return sample;
+        uint64_t count = buffer[0];
+        uint64_t time_enabled = buffer[1];
+        uint64_t time_running = buffer[2];
+        for(uint64_t k = 0; k < count && k < PLATFORM_PERF_EVENT_COUNT; k++) {
+            uint64_t value = buffer[3 + 2 * k];
+            uint64_t id = buffer[4 + 2 * k];
+            for(uint32_t i = 0; i < PLATFORM_PERF_EVENT_COUNT; i++) {
+                if(fds[i] >= 0 && ids[i] == id) {
+                    // extrapolates the time the group wasn't on the PMU
+                    if(time_running != 0 && time_running < time_enabled)
+                        value = (uint64_t)((double)value * time_enabled / time_running);
+                    sample.values[i] = value;
+                    sample.valid[i] = time_running != 0;
+                }
+            }
+        }
+        return sample;
+    }
+
+private:
+    void set_error(int code) {
+        if(code == EACCES || code == EPERM)
+            error = "perf_event_open not permitted (check /proc/sys/kernel/perf_event_paranoid)";
+        else if(code == ENOENT || code == EOPNOTSUPP || code == ENODEV)
+            error = "hardware counters are not exposed (no PMU or virtualized)";
+        else if(code == ENOSYS)
+            error = "perf_event_open is not supported by the kernel";
+        else
+            error = "perf_event_open failed";
+    }
+
+private:
+    int fds[PLATFORM_PERF_EVENT_COUNT];
+    uint64_t ids[PLATFORM_PERF_EVENT_COUNT] = {};
+    int leader_fd = -1;
+    const char *error = nullptr;
+};
+
+NAMESPACE_PLATFORM_END
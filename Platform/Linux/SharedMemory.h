@@ -0,0 +1,131 @@
+//
+//  SharedMemory.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#pragma once
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "../PlatformDefine.h"
+#include "../PlatformCommon.h"
+
+NAMESPACE_PLATFORM_BEGIN
+
+// Shared memory mapping (memfd, or an unlinked POSIX shm object)
+//
+// The descriptor is inherited by fork(), and can be passed to unrelated
+// processes with SCM_RIGHTS; the peer maps it with open(). The mapping may
+// land at a different address in every process.
+class platform_shared_memory {
+public:
+    platform_shared_memory() {}
+
+    ~platform_shared_memory() {
+        close();
+    }
+
+    platform_shared_memory(const platform_shared_memory&) = delete;
+    platform_shared_memory& operator=(const platform_shared_memory&) = delete;
+
+public:
+    // creates a zero-filled region
+    bool create(const char *name, size_t new_size) {
+        close();
+        int new_fd = -1;
+#ifdef SYS_memfd_create
+        new_fd = (int)syscall(SYS_memfd_create, name, 0);
+#endif
+        if(new_fd < 0) {
+            // kernels without memfd : a POSIX shm object that only lives in the descriptor
+            char path[64];
+            std::snprintf(path, sizeof(path), "/cpp_playground_%d_%p", (int)getpid(), (void*)this);
+            new_fd = shm_open(path, O_RDWR | O_CREAT | O_EXCL, 0600);
+            if(new_fd < 0)
+                return false;
+            shm_unlink(path);
+        }
+        if(ftruncate(new_fd, (off_t)new_size) != 0) {
+            ::close(new_fd);
+            return false;
+        }
+        return map(new_fd, new_size);
+    }
+
+    // maps a descriptor received from the creator (the descriptor is owned afterwards)
+    bool open(int existing_fd, size_t new_size) {
+        close();
+        return map(existing_fd, new_size);
+    }
+
+    void close() {
+        if(address != nullptr)
+            munmap(address, size);
+        if(fd >= 0)
+            ::close(fd);
+        address = nullptr;
+        size = 0;
+        fd = -1;
+    }
+
+    void *get_address() const { return address; }
+    size_t get_size() const { return size; }
+    int get_fd() const { return fd; }
+
+private:
+    bool map(int new_fd, size_t new_size) {
+        void *new_address = mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, new_fd, 0);
+        if(new_address == MAP_FAILED) {
+            ::close(new_fd);
+            return false;
+        }
+        fd = new_fd;
+        size = new_size;
+        address = new_address;
+        return true;
+    }
+
+private:
+    int fd = -1;
+    size_t size = 0;
+    void *address = nullptr;
+};
+
+inline uint32_t platform_get_process_id() {
+    return (uint32_t)getpid();
+}
+
+// false once the process has exited, zombies included (a recycled pid is taken for alive)
+inline bool platform_is_process_alive(uint32_t pid) {
+    if(kill((pid_t)pid, 0) != 0 && errno == ESRCH)
+        return false;
+    
+    // kill() succeeds until the parent reaps the process, so check its state :
+    // "pid (comm) S ...", comm may contain spaces and parentheses
+    char path[32];
+    std::snprintf(path, sizeof(path), "/proc/%u/stat", pid);
+    int stat_fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if(stat_fd < 0)
+        return true;
+    char buffer[512];
+    ssize_t length = ::read(stat_fd, buffer, sizeof(buffer) - 1);
+    ::close(stat_fd);
+    if(length <= 0)
+        return true;
+    buffer[length] = 0;
+    const char *state = std::strrchr(buffer, ')');
+    if(state == nullptr || state[1] != ' ')
+        return true;
+    return state[2] != 'Z' && state[2] != 'X';
+}
+
+NAMESPACE_PLATFORM_END
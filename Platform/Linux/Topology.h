@@ -0,0 +1,176 @@
+//
+//  Topology.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include "../PlatformDefine.h"
+#include "../PlatformCommon.h"
+
+// topology structures are declared by PlatformTopology.h before including this file
+
+#define PLATFORM_SYSFS_CPU_PATH "/sys/devices/system/cpu"
+
+NAMESPACE_PLATFORM_BEGIN
+
+// first line of a sysfs file (empty if missing)
+inline std::string platform_read_sysfs_line(const std::string &path) {
+    std::string line;
+    FILE *file = std::fopen(path.c_str(), "r");
+    if(file == nullptr)
+        return line;
+    char buffer[256];
+    if(std::fgets(buffer, sizeof(buffer), file) != nullptr)
+        line = buffer;
+    std::fclose(file);
+    while(!line.empty() && (line.back() == '\n' || line.back() == ' '))
+        line.pop_back();
+    return line;
+}
+
+inline int64_t platform_read_sysfs_int(const std::string &path, int64_t default_value) {
+    std::string line = platform_read_sysfs_line(path);
+    return line.empty() ? default_value : std::strtoll(line.c_str(), nullptr, 10);
+}
+
+// parses cpu lists like "0-3,8-11"
+inline std::vector<uint32_t> platform_parse_cpu_list(const std::string &list) {
+    std::vector<uint32_t> cpus;
+    const char *p = list.c_str();
+    while(*p != '\0') {
+        char *end;
+        unsigned long first = std::strtoul(p, &end, 10);
+        if(end == p)
+            break;
+        unsigned long last = first;
+        p = end;
+        if(*p == '-') {
+            last = std::strtoul(p + 1, &end, 10);
+            p = end;
+        }
+        for(unsigned long cpu = first; cpu <= last; cpu++)
+            cpus.push_back((uint32_t)cpu);
+        if(*p == ',')
+            p++;
+    }
+    return cpus;
+}
+
+// cache sizes are written like "48K" or "2M"
+inline uint64_t platform_parse_cache_size(const std::string &text) {
+    char *end;
+    uint64_t size = std::strtoull(text.c_str(), &end, 10);
+    if(*end == 'K')
+        size <<= 10;
+    else if(*end == 'M')
+        size <<= 20;
+    else if(*end == 'G')
+        size <<= 30;
+    return size;
+}
+
+// reads the cpus we may run on (online and in the affinity mask)
+inline void platform_read_topology(platform_topology &topology) {
+    std::string cpu_path = PLATFORM_SYSFS_CPU_PATH;
+    std::vector<uint32_t> online = platform_parse_cpu_list(platform_read_sysfs_line(cpu_path + "/online"));
+    cpu_set_t affinity;
+    CPU_ZERO(&affinity);
+    bool has_affinity = sched_getaffinity(0, sizeof(affinity), &affinity) == 0;
+    
+    std::map<std::pair<uint32_t, int64_t>, uint32_t> core_index;
+    std::map<uint32_t, uint32_t> package_index;
+    std::map<uint32_t, bool> numa_nodes;
+    for(uint32_t cpu : online) {
+        if(has_affinity && cpu < CPU_SETSIZE && !CPU_ISSET(cpu, &affinity))
+            continue;
+        std::string path = cpu_path + "/cpu" + std::to_string(cpu);
+        platform_cpu_info info;
+        info.cpu = cpu;
+        
+        uint32_t package = (uint32_t)platform_read_sysfs_int(path + "/topology/physical_package_id", 0);
+        if(package_index.find(package) == package_index.end())
+            package_index.emplace(package, (uint32_t)package_index.size());
+        info.package = package_index[package];
+        
+        int64_t core_id = platform_read_sysfs_int(path + "/topology/core_id", cpu);
+        auto core_key = std::make_pair(info.package, core_id);
+        if(core_index.find(core_key) == core_index.end())
+            core_index.emplace(core_key, (uint32_t)core_index.size());
+        info.core = core_index[core_key];
+        
+        std::vector<uint32_t> siblings = platform_parse_cpu_list(platform_read_sysfs_line(path + "/topology/thread_siblings_list"));
+        for(uint32_t sibling : siblings) {
+            if(sibling == cpu)
+                break;
+            info.smt_index++;
+        }
+        if(info.smt_index >= siblings.size())
+            info.smt_index = 0;
+        
+        // the cpu directory holds a nodeN link on NUMA kernels
+        if(DIR *dir = opendir(path.c_str())) {
+            while(dirent *entry = readdir(dir)) {
+                if(std::strncmp(entry->d_name, "node", 4) == 0 && entry->d_name[4] >= '0' && entry->d_name[4] <= '9') {
+                    info.numa_node = (uint32_t)std::strtoul(entry->d_name + 4, nullptr, 10);
+                    break;
+                }
+            }
+            closedir(dir);
+        }
+        numa_nodes[info.numa_node] = true;
+        topology.cpus.push_back(info);
+    }
+    
+    if(topology.cpus.empty()) {
+        platform_cpu_info info;
+        topology.cpus.push_back(info);
+        numa_nodes[0] = true;
+        package_index[0] = 0;
+        core_index[std::make_pair(0u, (int64_t)0)] = 0;
+    }
+    topology.num_physical_cores = (uint32_t)core_index.size();
+    topology.num_packages = (uint32_t)package_index.size();
+    topology.num_numa_nodes = (uint32_t)numa_nodes.size();
+    
+    std::string cache_path = cpu_path + "/cpu" + std::to_string(topology.cpus[0].cpu) + "/cache/index";
+    for(uint32_t index = 0; ; index++) {
+        std::string path = cache_path + std::to_string(index);
+        std::string type = platform_read_sysfs_line(path + "/type");
+        if(type.empty())
+            break;
+        platform_cache_info cache;
+        cache.level = (uint32_t)platform_read_sysfs_int(path + "/level", 0);
+        cache.type = type == "Data" ? 'D' : (type == "Instruction" ? 'I' : 'U');
+        cache.size = platform_parse_cache_size(platform_read_sysfs_line(path + "/size"));
+        cache.line_size = (uint32_t)platform_read_sysfs_int(path + "/coherency_line_size", 0);
+        cache.num_shared_cpus = (uint32_t)std::max<size_t>(1, platform_parse_cpu_list(platform_read_sysfs_line(path + "/shared_cpu_list")).size());
+        if(cache.level == 1 && cache.type != 'I' && cache.line_size != 0)
+            topology.cache_line_size = cache.line_size;
+        topology.caches.push_back(cache);
+    }
+}
+
+// returns false if the cpu is not usable
+inline bool platform_pin_current_thread(uint32_t cpu) {
+    if(cpu >= CPU_SETSIZE)
+        return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+NAMESPACE_PLATFORM_END
@@ -10,6 +10,11 @@
 
 #include "PlatformDefine.h"
 #include "PlatformCommon.h"
+#include "PlatformFutex.h"
+#include "PlatformTopology.h"
+#include "PlatformPerfCounters.h"
+#include "PlatformSharedMemory.h"
+#include "PlatformMembarrier.h"
 
 #if PLATFORM_APPLE
 
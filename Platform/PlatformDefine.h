@@ -43,6 +43,13 @@
 // Assumes that the cache line size is 64 in both ARM and AMD64.
 #define PLATFORM_CACHE_LINE_SIZE 64
 
+#elif defined(__linux__)
+
+// Linux variant
+#define PLATFORM_LINUX 1
+// Assumes that the cache line size is 64 in both x86-64 and ARM64.
+#define PLATFORM_CACHE_LINE_SIZE 64
+
 #endif
 
 #ifndef PLATFORM_CACHE_LINE_SIZE
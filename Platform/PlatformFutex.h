@@ -0,0 +1,36 @@
+//
+//  PlatformFutex.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef PlatformFutex_h
+#define PlatformFutex_h
+
+#include "PlatformDefine.h"
+#include "PlatformCommon.h"
+
+// address-based wait/wake (platform_futex_wait, platform_futex_wake_one, platform_futex_wake_all)
+#if PLATFORM_LINUX
+
+#define SUPPORTS_PLATFORM_FUTEX 1
+#include "Linux/Futex.h"
+
+#elif PLATFORM_APPLE
+
+#define SUPPORTS_PLATFORM_FUTEX 1
+#include "Apple/Futex.h"
+
+#elif PLATFORM_WINDOWS
+
+#define SUPPORTS_PLATFORM_FUTEX 1
+#include "Windows/Futex.h"
+
+#else
+
+#define SUPPORTS_PLATFORM_FUTEX 0
+
+#endif
+
+#endif /* PlatformFutex_h */
@@ -0,0 +1,38 @@
+//
+//  PlatformMembarrier.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef PlatformMembarrier_h
+#define PlatformMembarrier_h
+
+#include "PlatformDefine.h"
+#include "PlatformCommon.h"
+
+// process-wide memory barrier (platform_membarrier_is_supported, platform_membarrier)
+#if PLATFORM_LINUX
+
+#define SUPPORTS_PLATFORM_MEMBARRIER 1
+#include "Linux/Membarrier.h"
+
+#else
+
+#define SUPPORTS_PLATFORM_MEMBARRIER 0
+
+NAMESPACE_PLATFORM_BEGIN
+
+inline bool platform_membarrier_is_supported() {
+    return false;
+}
+
+inline bool platform_membarrier() {
+    return false;
+}
+
+NAMESPACE_PLATFORM_END
+
+#endif
+
+#endif /* PlatformMembarrier_h */
@@ -0,0 +1,83 @@
+//
+//  PlatformPerfCounters.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef PlatformPerfCounters_h
+#define PlatformPerfCounters_h
+
+#include <cstdint>
+#include "PlatformDefine.h"
+#include "PlatformCommon.h"
+
+NAMESPACE_PLATFORM_BEGIN
+
+// hardware events counted by platform_perf_counters
+enum platform_perf_event : uint32_t {
+    PLATFORM_PERF_CYCLES,
+    PLATFORM_PERF_INSTRUCTIONS,
+    PLATFORM_PERF_LLC_MISSES,
+    PLATFORM_PERF_BRANCH_MISSES,
+    PLATFORM_PERF_DTLB_MISSES,
+    PLATFORM_PERF_EVENT_COUNT,
+};
+
+inline const char *platform_get_perf_event_name(uint32_t event) {
+    static const char *names[PLATFORM_PERF_EVENT_COUNT] = { "cycles", "instructions", "llc_misses", "branch_misses", "dtlb_misses" };
+    return event < PLATFORM_PERF_EVENT_COUNT ? names[event] : "unknown";
+}
+
+// counter values (scaled when the kernel multiplexed the group)
+struct platform_perf_sample {
+    uint64_t values[PLATFORM_PERF_EVENT_COUNT] = {};
+    bool valid[PLATFORM_PERF_EVENT_COUNT] = {};
+
+    void add(const platform_perf_sample &other) {
+        for(uint32_t i = 0; i < PLATFORM_PERF_EVENT_COUNT; i++) {
+            values[i] += other.values[i];
+            valid[i] |= other.valid[i];
+        }
+    }
+
+    bool has_any() const {
+        for(uint32_t i = 0; i < PLATFORM_PERF_EVENT_COUNT; i++) {
+            if(valid[i])
+                return true;
+        }
+        return false;
+    }
+};
+
+NAMESPACE_PLATFORM_END
+
+// platform_perf_counters (per-thread counter group)
+#if PLATFORM_LINUX
+
+#define SUPPORTS_PLATFORM_PERF_COUNTERS 1
+#include "Linux/PerfCounters.h"
+
+#else
+
+#define SUPPORTS_PLATFORM_PERF_COUNTERS 0
+
+NAMESPACE_PLATFORM_BEGIN
+
+// counters are never available, every call is a no-op
+class platform_perf_counters {
+public:
+    bool open() { return false; }
+    void close() {}
+    bool is_open() const { return false; }
+    const char *get_error() const { return "hardware counters are not supported on this platform"; }
+    void start() {}
+    void stop() {}
+    platform_perf_sample read() const { return platform_perf_sample(); }
+};
+
+NAMESPACE_PLATFORM_END
+
+#endif
+
+#endif /* PlatformPerfCounters_h */
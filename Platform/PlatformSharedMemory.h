@@ -0,0 +1,52 @@
+//
+//  PlatformSharedMemory.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef PlatformSharedMemory_h
+#define PlatformSharedMemory_h
+
+#include <cstddef>
+#include <cstdint>
+#include "PlatformDefine.h"
+#include "PlatformCommon.h"
+
+// platform_shared_memory, platform_get_process_id, platform_is_process_alive
+#if PLATFORM_LINUX
+
+#define SUPPORTS_PLATFORM_SHARED_MEMORY 1
+#include "Linux/SharedMemory.h"
+
+#else
+
+#define SUPPORTS_PLATFORM_SHARED_MEMORY 0
+
+NAMESPACE_PLATFORM_BEGIN
+
+// no inter-process mapping, create() always fails
+class platform_shared_memory {
+public:
+    bool create(const char*, size_t) { return false; }
+    bool open(int, size_t) { return false; }
+    void close() {}
+    void *get_address() const { return nullptr; }
+    size_t get_size() const { return 0; }
+    int get_fd() const { return -1; }
+};
+
+inline uint32_t platform_get_process_id() {
+    return 1;
+}
+
+// without a way to tell, peers are assumed to be alive
+inline bool platform_is_process_alive(uint32_t) {
+    return true;
+}
+
+NAMESPACE_PLATFORM_END
+
+#endif
+
+#endif /* PlatformSharedMemory_h */
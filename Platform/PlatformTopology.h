@@ -0,0 +1,181 @@
+//
+//  PlatformTopology.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef PlatformTopology_h
+#define PlatformTopology_h
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "PlatformDefine.h"
+#include "PlatformCommon.h"
+
+NAMESPACE_PLATFORM_BEGIN
+
+// cache seen by the first usable cpu
+struct platform_cache_info {
+    uint32_t level = 0;
+    // 'D'ata, 'I'nstruction or 'U'nified
+    char type = 'U';
+    uint64_t size = 0;
+    uint32_t line_size = 0;
+    // number of logical cpus sharing the cache
+    uint32_t num_shared_cpus = 1;
+};
+
+// usable logical cpu
+struct platform_cpu_info {
+    uint32_t cpu = 0;
+    uint32_t package = 0;
+    // dense physical core index (unique across packages)
+    uint32_t core = 0;
+    // position among the SMT siblings of the core
+    uint32_t smt_index = 0;
+    uint32_t numa_node = 0;
+};
+
+struct platform_topology {
+    // ordered by cpu number
+    std::vector<platform_cpu_info> cpus;
+    std::vector<platform_cache_info> caches;
+    uint32_t num_physical_cores = 0;
+    uint32_t num_packages = 0;
+    uint32_t num_numa_nodes = 0;
+    // measured line size (PLATFORM_CACHE_LINE_SIZE is the compile-time guess)
+    uint32_t cache_line_size = PLATFORM_CACHE_LINE_SIZE;
+    
+    // largest cache of the level, 0 if unknown
+    uint64_t get_cache_size(uint32_t level, bool data = true) const {
+        uint64_t size = 0;
+        for(const platform_cache_info &cache : caches) {
+            if(cache.level == level && (cache.type != (data ? 'I' : 'D')))
+                size = std::max(size, cache.size);
+        }
+        return size;
+    }
+};
+
+// thread placement policies
+enum class platform_placement {
+    // not pinned, the scheduler decides
+    none,
+    // fill SMT siblings, then cores, then packages
+    compact,
+    // spread across packages and cores first, SMT siblings last
+    scatter,
+    // a single thread per physical core (wraps around when oversubscribed)
+    physical_cores,
+};
+
+NAMESPACE_PLATFORM_END
+
+// platform_read_topology, platform_pin_current_thread
+#if PLATFORM_LINUX
+
+#define SUPPORTS_PLATFORM_TOPOLOGY 1
+#include "Linux/Topology.h"
+
+#else
+
+#define SUPPORTS_PLATFORM_TOPOLOGY 0
+
+NAMESPACE_PLATFORM_BEGIN
+
+// every hardware thread is assumed to be its own core
+inline void platform_read_topology(platform_topology &topology) {
+    uint32_t num_cpus = std::max(1u, (uint32_t)std::thread::hardware_concurrency());
+    for(uint32_t i = 0; i < num_cpus; i++) {
+        platform_cpu_info info;
+        info.cpu = i;
+        info.core = i;
+        topology.cpus.push_back(info);
+    }
+    topology.num_physical_cores = num_cpus;
+    topology.num_packages = 1;
+    topology.num_numa_nodes = 1;
+}
+
+inline bool platform_pin_current_thread(uint32_t) {
+    return false;
+}
+
+NAMESPACE_PLATFORM_END
+
+#endif
+
+NAMESPACE_PLATFORM_BEGIN
+
+// topology of the usable cpus, read once
+inline const platform_topology &platform_get_topology() {
+    static const platform_topology topology = []() {
+        platform_topology result;
+        platform_read_topology(result);
+        return result;
+    }();
+    return topology;
+}
+
+// cpu numbers for num_threads threads under the policy (empty for none)
+inline std::vector<uint32_t> platform_get_placement(platform_placement placement, uint32_t num_threads, const platform_topology &topology = platform_get_topology()) {
+    std::vector<uint32_t> result;
+    if(placement == platform_placement::none || topology.cpus.empty())
+        return result;
+    
+    std::vector<platform_cpu_info> order = topology.cpus;
+    if(placement == platform_placement::compact) {
+        std::stable_sort(order.begin(), order.end(), [](const platform_cpu_info &a, const platform_cpu_info &b) {
+            if(a.package != b.package)
+                return a.package < b.package;
+            if(a.core != b.core)
+                return a.core < b.core;
+            return a.smt_index < b.smt_index;
+        });
+    }
+    else {
+        // rank of each core within its package, so packages are interleaved
+        std::vector<uint32_t> core_rank(topology.num_physical_cores, 0);
+        std::vector<uint32_t> package_cores(topology.num_packages, 0);
+        std::vector<bool> ranked(topology.num_physical_cores, false);
+        for(const platform_cpu_info &info : topology.cpus) {
+            if(!ranked[info.core]) {
+                ranked[info.core] = true;
+                core_rank[info.core] = package_cores[info.package]++;
+            }
+        }
+        std::stable_sort(order.begin(), order.end(), [&core_rank](const platform_cpu_info &a, const platform_cpu_info &b) {
+            if(a.smt_index != b.smt_index)
+                return a.smt_index < b.smt_index;
+            if(core_rank[a.core] != core_rank[b.core])
+                return core_rank[a.core] < core_rank[b.core];
+            return a.package < b.package;
+        });
+        if(placement == platform_placement::physical_cores) {
+            order.erase(std::remove_if(order.begin(), order.end(), [](const platform_cpu_info &info) {
+                return info.smt_index != 0;
+            }), order.end());
+        }
+    }
+    
+    result.reserve(num_threads);
+    for(uint32_t i = 0; i < num_threads; i++)
+        result.push_back(order[i % order.size()].cpu);
+    return result;
+}
+
+inline const char *platform_get_placement_name(platform_placement placement) {
+    switch(placement) {
+        case platform_placement::compact: return "compact";
+        case platform_placement::scatter: return "scatter";
+        case platform_placement::physical_cores: return "physical_cores";
+        default: return "none";
+    }
+}
+
+NAMESPACE_PLATFORM_END
+
+#endif /* PlatformTopology_h */
@@ -0,0 +1,36 @@
+//
+//  Futex.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <Windows.h>
+#include "../PlatformDefine.h"
+#include "../PlatformCommon.h"
+
+#pragma comment(lib, "Synchronization.lib")
+
+NAMESPACE_PLATFORM_BEGIN
+
+// blocks while *address == expected, returns false on timeout (timeout_ns < 0 : infinite)
+inline bool platform_futex_wait(std::atomic<uint32_t> *address, uint32_t expected, int64_t timeout_ns = -1) {
+    DWORD timeout_ms = timeout_ns < 0 ? INFINITE : (DWORD)((timeout_ns + 999999) / 1000000);
+    if(WaitOnAddress((volatile VOID*)address, &expected, sizeof(uint32_t), timeout_ms))
+        return true;
+    return GetLastError() != ERROR_TIMEOUT;
+}
+
+inline void platform_futex_wake_one(std::atomic<uint32_t> *address) {
+    WakeByAddressSingle((PVOID)address);
+}
+
+inline void platform_futex_wake_all(std::atomic<uint32_t> *address) {
+    WakeByAddressAll((PVOID)address);
+}
+
+NAMESPACE_PLATFORM_END
@@ -0,0 +1,120 @@
+//
+//  AsymmetricLock.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef AsymmetricLock_h
+#define AsymmetricLock_h
+
+#include <atomic>
+#include <cstdint>
+#include "Mutex.h"
+#include "../Thread/ThreadLocal.h"
+#include "../../Platform/PlatformDefine.h"
+#include "../../Platform/PlatformMembarrier.h"
+
+// threads with a dense id below this get a reader flag, the others take the fallback lock
+#define ASYMMETRIC_LOCK_MAX_READERS 256
+
+// Reader-biased lock with an asymmetric fence (membarrier)
+//
+// A reader stores to its own flag and checks the writer flag with an
+// acquire load (a plain load on x86 and ARM64), with only a compiler barrier
+// in between; the store-load ordering that would need a fence is provided
+// by the writer instead, whose membarrier() makes every running thread
+// execute a full barrier. After it, a reader either sees the writer flag
+// and backs off, or its flag is visible to the writer's scan. The acquire
+// load pairs with the release in unlock(), so a reader entering after a
+// writer sees its updates.
+// Writers are serialized by an rw_spinlock_mutex, which is also the whole
+// lock where membarrier isn't supported, and for threads without a flag.
+class asymmetric_rw_mutex {
+public:
+    asymmetric_rw_mutex(int new_spin_count = DEFAULT_SPIN_COUNT) : spin_count(new_spin_count), fallback(new_spin_count) {
+        use_membarrier = platform::platform_membarrier_is_supported();
+    }
+
+    inline void lock_shared() {
+        threadlocal_thread_id id = threadlocal_get_thread_id();
+        if(!use_membarrier || id >= ASYMMETRIC_LOCK_MAX_READERS) {
+            fallback.lock_shared();
+            return;
+        }
+        reader_slot_t &slot = reader_slots[id];
+        uint32_t depth = slot.depth.load(std::memory_order_relaxed);
+        if(depth > 0) {
+            // nested, the writer is already held off
+            slot.depth.store(depth + 1, std::memory_order_relaxed);
+            return;
+        }
+        for(;;) {
+            slot.depth.store(1, std::memory_order_relaxed);
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+            if(!writer.load(std::memory_order_acquire)) {
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+                return;
+            }
+
+            // a writer is active or waiting, step aside until it is done
+            slot.depth.store(0, std::memory_order_release);
+            spin_wait waiter(spin_count);
+            while(writer.load(std::memory_order_acquire))
+                waiter.wait();
+        }
+    }
+
+    inline void unlock_shared() {
+        threadlocal_thread_id id = threadlocal_get_thread_id();
+        if(!use_membarrier || id >= ASYMMETRIC_LOCK_MAX_READERS) {
+            fallback.unlock_shared();
+            return;
+        }
+        // release keeps the reads inside (a plain store on x86)
+        reader_slot_t &slot = reader_slots[id];
+        slot.depth.store(slot.depth.load(std::memory_order_relaxed) - 1, std::memory_order_release);
+    }
+
+    void lock() {
+        fallback.lock();
+        if(!use_membarrier)
+            return;
+        writer.store(true, std::memory_order_relaxed);
+        platform::platform_membarrier();
+
+        // ids are registered before their first flag store, so the capacity covers every reader seen
+        uint32_t num_slots = global_thread_registry.get_id_capacity();
+        if(num_slots > ASYMMETRIC_LOCK_MAX_READERS)
+            num_slots = ASYMMETRIC_LOCK_MAX_READERS;
+        spin_wait waiter(spin_count);
+        for(uint32_t i = 0; i < num_slots; i++) {
+            while(reader_slots[i].depth.load(std::memory_order_acquire) != 0)
+                waiter.wait();
+        }
+    }
+
+    void unlock() {
+        if(use_membarrier)
+            writer.store(false, std::memory_order_release);
+        fallback.unlock();
+    }
+
+    // false when every reader goes through the fallback lock
+    inline bool is_asymmetric() const { return use_membarrier; }
+
+private:
+    // written only by its own thread
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) reader_slot_t {
+        std::atomic<uint32_t> depth{0};
+    };
+
+private:
+    bool use_membarrier;
+    int spin_count;
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<bool> writer{false};
+    rw_spinlock_mutex fallback;
+    reader_slot_t reader_slots[ASYMMETRIC_LOCK_MAX_READERS];
+};
+
+#endif /* AsymmetricLock_h */
@@ -0,0 +1,200 @@
+//
+//  BoundedStack.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef BoundedStack_h
+#define BoundedStack_h
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include "../Thread/Tracer.h"
+#include "../../Platform/PlatformDefine.h"
+
+// index returned by an empty list
+#define INDEX_LIST_EMPTY UINT32_MAX
+
+// Index list (Treiber stack of 32-bit indices with a 32-bit tag)
+//
+// The head is { tag : 32, index + 1 : 32 } in one 64-bit word, so it never
+// depends on the address layout (57-bit address spaces, tagged pointers)
+// and the tag needs 2^32 successful operations on the same head to wrap,
+// instead of the 4096 of lf_stack's counter. Links live in an array owned
+// by the caller; an index must be in one list at a time, so several lists
+// can share the same link array.
+class index_list {
+public:
+    index_list() {}
+
+    index_list(const index_list&) = delete;
+    index_list& operator=(const index_list&) = delete;
+
+public:
+    void push(std::atomic<uint32_t> *links, uint32_t index) {
+        uint64_t old_head = head.load(std::memory_order_relaxed);
+        for(;;) {
+            links[index].store((uint32_t)old_head, std::memory_order_relaxed);
+            uint64_t new_head = get_next_tag(old_head) | (index + 1);
+            if(head.compare_exchange_weak(old_head, new_head, std::memory_order_release, std::memory_order_relaxed))
+                return;
+            TRACE_INSTANT("index_list push cas retry");
+        }
+    }
+
+    // returns INDEX_LIST_EMPTY when the list is empty
+    uint32_t pop(std::atomic<uint32_t> *links) {
+        uint64_t old_head = head.load(std::memory_order_acquire);
+        for(;;) {
+            uint32_t top = (uint32_t)old_head;
+            if(top == 0)
+                return INDEX_LIST_EMPTY;
+            // the link may belong to an index popped meanwhile, the tag fails the CAS then
+            uint64_t new_head = get_next_tag(old_head) | links[top - 1].load(std::memory_order_relaxed);
+            if(head.compare_exchange_weak(old_head, new_head, std::memory_order_acquire, std::memory_order_acquire))
+                return top - 1;
+            TRACE_INSTANT("index_list pop cas retry");
+        }
+    }
+
+    // links first..count-1 in order, only before the list is shared
+    void reset(std::atomic<uint32_t> *links, uint32_t count) {
+        for(uint32_t i = 0; i < count; i++)
+            links[i].store(i + 1 < count ? i + 2 : 0, std::memory_order_relaxed);
+        head.store(count > 0 ? 1 : 0, std::memory_order_release);
+    }
+
+    // racy, a hint only
+    bool empty() const {
+        return (uint32_t)head.load(std::memory_order_relaxed) == 0;
+    }
+
+private:
+    static inline uint64_t get_next_tag(uint64_t old_head) {
+        return ((old_head >> 32) + 1) << 32;
+    }
+
+private:
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64_t> head{0};
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "index_list needs a lock-free 64-bit CAS!");
+};
+
+// Bounded lock-free stack (preallocated nodes, no allocation after construction)
+//
+// Nodes move between a free list and the stack list, both index_lists over
+// one link array. push() fails when every node is in use.
+template<typename T>
+class bounded_lf_stack {
+public:
+    bounded_lf_stack(uint32_t new_capacity) : capacity(new_capacity) {
+        assert(capacity < INDEX_LIST_EMPTY);
+        values = new T[capacity];
+        links = new std::atomic<uint32_t>[capacity];
+        free_list.reset(links, capacity);
+    }
+
+    ~bounded_lf_stack() {
+        delete[] values;
+        delete[] links;
+    }
+
+    bounded_lf_stack(const bounded_lf_stack&) = delete;
+    bounded_lf_stack& operator=(const bounded_lf_stack&) = delete;
+
+public:
+    // returns false when the stack is full
+    bool push(const T &value) {
+        uint32_t index = free_list.pop(links);
+        if(index == INDEX_LIST_EMPTY)
+            return false;
+        values[index] = value;
+        stack_list.push(links, index);
+        return true;
+    }
+
+    bool pop(T &out_value) {
+        uint32_t index = stack_list.pop(links);
+        if(index == INDEX_LIST_EMPTY)
+            return false;
+        out_value = std::move(values[index]);
+        free_list.push(links, index);
+        return true;
+    }
+
+    inline uint32_t get_capacity() const { return capacity; }
+
+private:
+    const uint32_t capacity;
+    T *values;
+    std::atomic<uint32_t> *links;
+    index_list free_list;
+    index_list stack_list;
+};
+
+// Bounded object pool (fixed slots, constructed on allocate)
+//
+// A lock-free replacement for new/delete of one type when the number of
+// live objects has a known upper bound.
+template<typename T>
+class bounded_object_pool {
+public:
+    bounded_object_pool(uint32_t new_capacity) : capacity(new_capacity) {
+        assert(capacity < INDEX_LIST_EMPTY);
+        storage = new storage_t[capacity];
+        links = new std::atomic<uint32_t>[capacity];
+        free_list.reset(links, capacity);
+    }
+
+    // objects still allocated are not destroyed
+    ~bounded_object_pool() {
+        delete[] storage;
+        delete[] links;
+    }
+
+    bounded_object_pool(const bounded_object_pool&) = delete;
+    bounded_object_pool& operator=(const bounded_object_pool&) = delete;
+
+public:
+    // returns nullptr when every slot is in use
+    template<typename... args_t>
+    T *allocate(args_t&&... args) {
+        uint32_t index = free_list.pop(links);
+        if(index == INDEX_LIST_EMPTY)
+            return nullptr;
+        return new (&storage[index]) T(std::forward<args_t>(args)...);
+    }
+
+    void free(T *ptr) {
+        uint32_t index = get_index(ptr);
+        ptr->~T();
+        free_list.push(links, index);
+    }
+
+    // stable slot index of an allocated object (fits in 32 bits)
+    inline uint32_t get_index(const T *ptr) const {
+        assert((const storage_t*)ptr >= storage && (const storage_t*)ptr < storage + capacity);
+        return (uint32_t)((const storage_t*)ptr - storage);
+    }
+
+    inline T *get_object(uint32_t index) const { return (T*)&storage[index]; }
+    inline uint32_t get_capacity() const { return capacity; }
+
+private:
+    struct storage_t {
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+private:
+    const uint32_t capacity;
+    storage_t *storage;
+    std::atomic<uint32_t> *links;
+    index_list free_list;
+};
+
+#endif /* BoundedStack_h */
@@ -0,0 +1,358 @@
+//
+//  ConcurrentHashMap.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef ConcurrentHashMap_h
+#define ConcurrentHashMap_h
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <utility>
+#include "Mutex.h"
+#include "../../Option/Option.h"
+#include "../../Platform/PlatformDefine.h"
+
+#if USE_MEMORY_POOL
+#include "../Memory/MemoryPool.h"
+#endif
+
+// number of lock stripes (must be power of 2)
+#define DEFAULT_HASH_MAP_STRIPE_COUNT 64
+
+// average number of nodes per bucket before growing the table
+#define DEFAULT_HASH_MAP_LOAD_FACTOR 2
+
+// number of old buckets moved to the new table per write while resizing
+#define HASH_MAP_MIGRATION_STEP 8
+
+// upper bits of the migration cursor hold the resize generation
+#define HASH_MAP_GENERATION_SHIFT 40
+
+// Concurrent hash map (striped bucket locks with incremental resize)
+//
+// Bucket i is guarded by stripe (i & (stripe_count - 1)). Table sizes are
+// power of 2 and never smaller than the stripe count, so a key maps to the
+// same stripe in both the old and the new table. While resizing, the old
+// table is drained a few buckets at a time by writers instead of rehashing
+// everything at once; lookups check both tables under one stripe lock.
+template<typename K, typename V, typename hash_t = std::hash<K>>
+class concurrent_hash_map {
+public:
+    concurrent_hash_map(size_t initial_bucket_count = 1024) {
+        size_t bucket_count = DEFAULT_HASH_MAP_STRIPE_COUNT;
+        while(bucket_count < initial_bucket_count)
+            bucket_count <<= 1;
+        table = new table_t(bucket_count);
+        old_table = nullptr;
+        for(size_t i = 0; i < DEFAULT_HASH_MAP_STRIPE_COUNT; i++)
+            stripes[i].mutex.set_lock_name("concurrent_hash_map stripe");
+        grow_threshold.store(bucket_count * DEFAULT_HASH_MAP_LOAD_FACTOR / DEFAULT_HASH_MAP_STRIPE_COUNT, std::memory_order_relaxed);
+    }
+
+    ~concurrent_hash_map() {
+        clear_table(table);
+        delete table;
+        if(old_table != nullptr) {
+            clear_table(old_table);
+            delete old_table;
+        }
+    }
+
+    concurrent_hash_map(const concurrent_hash_map&) = delete;
+    concurrent_hash_map& operator=(const concurrent_hash_map&) = delete;
+
+public:
+    // inserts the value if the key doesn't exist
+    bool insert(const K &key, const V &value) {
+        size_t hash = hasher(key);
+        stripe_t &stripe = get_stripe(hash);
+        size_t stripe_count;
+        {
+            scoped_lock<spinlock_mutex> lock{ &stripe.mutex };
+            if(find_node(hash, key) != nullptr)
+                return false;
+            link_node(table, new node_t(hash, key, value));
+            stripe_count = stripe.add_count(1);
+        }
+        after_write(stripe_count);
+        return true;
+    }
+
+    // inserts the value or overwrites the existing one (returns true if inserted)
+    bool insert_or_assign(const K &key, const V &value) {
+        size_t hash = hasher(key);
+        stripe_t &stripe = get_stripe(hash);
+        size_t stripe_count;
+        {
+            scoped_lock<spinlock_mutex> lock{ &stripe.mutex };
+            node_t *node = find_node(hash, key);
+            if(node != nullptr) {
+                node->value = value;
+                return false;
+            }
+            link_node(table, new node_t(hash, key, value));
+            stripe_count = stripe.add_count(1);
+        }
+        after_write(stripe_count);
+        return true;
+    }
+
+    bool find(const K &key, V &out_value) {
+        size_t hash = hasher(key);
+        stripe_t &stripe = get_stripe(hash);
+        scoped_lock<spinlock_mutex> lock{ &stripe.mutex };
+        node_t *node = find_node(hash, key);
+        if(node == nullptr)
+            return false;
+        out_value = node->value;
+        return true;
+    }
+
+    bool contains(const K &key) {
+        size_t hash = hasher(key);
+        stripe_t &stripe = get_stripe(hash);
+        scoped_lock<spinlock_mutex> lock{ &stripe.mutex };
+        return find_node(hash, key) != nullptr;
+    }
+
+    bool erase(const K &key) {
+        size_t hash = hasher(key);
+        stripe_t &stripe = get_stripe(hash);
+        size_t stripe_count;
+        node_t *node;
+        {
+            scoped_lock<spinlock_mutex> lock{ &stripe.mutex };
+            node = unlink_node(table, hash, key);
+            if(node == nullptr && old_table != nullptr)
+                node = unlink_node(old_table, hash, key);
+            if(node == nullptr)
+                return false;
+            stripe_count = stripe.add_count(-1);
+        }
+        delete node;
+        after_write(stripe_count);
+        return true;
+    }
+
+    // approximate element count (exact when no writer is running)
+    size_t size() {
+        size_t total = 0;
+        for(size_t i = 0; i < DEFAULT_HASH_MAP_STRIPE_COUNT; i++)
+            total += stripes[i].count.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    // debug-only bucket count (not thread-safe)
+    size_t debug_bucket_count() const { return table->bucket_count; }
+
+    // debug-only resize state (not thread-safe)
+    bool debug_is_resizing() const { return old_table != nullptr; }
+
+private:
+    // internal node structure
+    struct node_t {
+        node_t *next;
+        size_t hash;
+        K key;
+        V value;
+
+        node_t(size_t in_hash, const K &in_key, const V &in_value) : next(nullptr), hash(in_hash), key(in_key), value(in_value) {}
+
+#if USE_MEMORY_POOL
+        static void *operator new(size_t size) {
+            if constexpr (sizeof(node_t) <= BLOCK_SIZE_LIST[NUM_BLOCK_SIZE - 1])
+                return global_memory_pool.allocate(size);
+            else
+                return ::operator new(size);
+        }
+
+        static void operator delete(void *ptr) {
+            if constexpr (sizeof(node_t) <= BLOCK_SIZE_LIST[NUM_BLOCK_SIZE - 1])
+                global_memory_pool.free(ptr);
+            else
+                ::operator delete(ptr);
+        }
+#endif
+    };
+
+    // bucket array
+    struct table_t {
+        size_t bucket_count;
+        node_t **buckets;
+
+        table_t(size_t new_bucket_count) : bucket_count(new_bucket_count) {
+            buckets = new node_t*[bucket_count]();
+        }
+        ~table_t() {
+            delete[] buckets;
+        }
+
+        inline node_t *&bucket(size_t hash) { return buckets[hash & (bucket_count - 1)]; }
+    };
+
+    // lock stripe with its element count
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) stripe_t {
+        spinlock_mutex mutex;
+        // written with the stripe lock held, read without it by size()
+        std::atomic<size_t> count{0};
+
+        inline size_t add_count(ptrdiff_t diff) {
+            size_t new_count = count.load(std::memory_order_relaxed) + diff;
+            count.store(new_count, std::memory_order_relaxed);
+            return new_count;
+        }
+    };
+
+private:
+    inline stripe_t &get_stripe(size_t hash) {
+        return stripes[hash & (DEFAULT_HASH_MAP_STRIPE_COUNT - 1)];
+    }
+
+    // both tables must be accessed with the stripe lock held
+    node_t *find_node(size_t hash, const K &key) {
+        for(node_t *node = table->bucket(hash); node != nullptr; node = node->next) {
+            if(node->hash == hash && node->key == key)
+                return node;
+        }
+        if(old_table != nullptr) {
+            for(node_t *node = old_table->bucket(hash); node != nullptr; node = node->next) {
+                if(node->hash == hash && node->key == key)
+                    return node;
+            }
+        }
+        return nullptr;
+    }
+
+    static void link_node(table_t *target, node_t *node) {
+        node_t *&head = target->bucket(node->hash);
+        node->next = head;
+        head = node;
+    }
+
+    static node_t *unlink_node(table_t *target, size_t hash, const K &key) {
+        node_t **prev = &target->bucket(hash);
+        for(node_t *node = *prev; node != nullptr; prev = &node->next, node = node->next) {
+            if(node->hash == hash && node->key == key) {
+                *prev = node->next;
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    static void clear_table(table_t *target) {
+        for(size_t i = 0; i < target->bucket_count; i++) {
+            node_t *node = target->buckets[i];
+            while(node != nullptr) {
+                node_t *next = node->next;
+                delete node;
+                node = next;
+            }
+            target->buckets[i] = nullptr;
+        }
+    }
+
+    // starts a resize or helps the running one
+    void after_write(size_t stripe_count) {
+        if(resizing.load(std::memory_order_acquire)) {
+            migrate(HASH_MAP_MIGRATION_STEP);
+        }
+        else if(stripe_count > grow_threshold.load(std::memory_order_relaxed)) {
+            begin_resize();
+        }
+    }
+
+    void lock_all_stripes() {
+        for(size_t i = 0; i < DEFAULT_HASH_MAP_STRIPE_COUNT; i++)
+            stripes[i].mutex.lock();
+    }
+
+    void unlock_all_stripes() {
+        for(size_t i = DEFAULT_HASH_MAP_STRIPE_COUNT; i > 0; i--)
+            stripes[i - 1].mutex.unlock();
+    }
+
+    // swaps in a table of twice the size (no element is moved here)
+    void begin_resize() {
+        bool expected = false;
+        if(!resizing.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+            return;
+
+        table_t *new_table = new table_t(table->bucket_count * 2);
+        lock_all_stripes();
+        old_table = table;
+        table = new_table;
+        generation++;
+        migrate_cursor.store(generation << HASH_MAP_GENERATION_SHIFT, std::memory_order_relaxed);
+        migrated_count.store(0, std::memory_order_relaxed);
+        grow_threshold.store(new_table->bucket_count * DEFAULT_HASH_MAP_LOAD_FACTOR / DEFAULT_HASH_MAP_STRIPE_COUNT, std::memory_order_relaxed);
+        unlock_all_stripes();
+    }
+
+    // moves up to max_buckets old buckets into the current table
+    void migrate(size_t max_buckets) {
+        for(size_t n = 0; n < max_buckets; n++) {
+            // the cursor carries the resize generation, so a claim taken from a
+            // finished resize is never applied to the next one.
+            uint64_t claim = migrate_cursor.fetch_add(1, std::memory_order_relaxed);
+            uint64_t claim_generation = claim >> HASH_MAP_GENERATION_SHIFT;
+            size_t index = (size_t)(claim & ((uint64_t(1) << HASH_MAP_GENERATION_SHIFT) - 1));
+            size_t old_bucket_count;
+
+            {
+                stripe_t &stripe = stripes[index & (DEFAULT_HASH_MAP_STRIPE_COUNT - 1)];
+                scoped_lock<spinlock_mutex> lock{ &stripe.mutex };
+                if(old_table == nullptr || generation != claim_generation || index >= old_table->bucket_count)
+                    return;
+
+                old_bucket_count = old_table->bucket_count;
+                node_t *node = old_table->buckets[index];
+                old_table->buckets[index] = nullptr;
+                while(node != nullptr) {
+                    node_t *next = node->next;
+                    link_node(table, node);
+                    node = next;
+                }
+            }
+
+            // a valid claim keeps the resize alive until it is counted here
+            if(migrated_count.fetch_add(1, std::memory_order_acq_rel) + 1 == old_bucket_count) {
+                end_resize();
+                return;
+            }
+        }
+    }
+
+    void end_resize() {
+        lock_all_stripes();
+        table_t *drained_table = old_table;
+        old_table = nullptr;
+        unlock_all_stripes();
+        delete drained_table;
+        resizing.store(false, std::memory_order_release);
+    }
+
+private:
+    hash_t hasher;
+    stripe_t stripes[DEFAULT_HASH_MAP_STRIPE_COUNT];
+
+    // table pointers are only swapped with every stripe lock held
+    table_t *table;
+    table_t *old_table;
+
+    uint64_t generation = 0;
+
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<bool> resizing{false};
+    std::atomic<size_t> grow_threshold;
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64_t> migrate_cursor{0};
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<size_t> migrated_count{0};
+
+    static_assert((DEFAULT_HASH_MAP_STRIPE_COUNT & (DEFAULT_HASH_MAP_STRIPE_COUNT - 1)) == 0, "The stripe count must be power of 2!");
+};
+
+#endif /* ConcurrentHashMap_h */
@@ -0,0 +1,151 @@
+//
+//  EventCount.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef EventCount_h
+#define EventCount_h
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include "LockFreeStack.h"
+#include "../../Platform/PlatformFutex.h"
+
+// Event count (blocking for lock-free structures without touching their fast path)
+//
+// A consumer registers itself with prepare_wait(), checks its condition once
+// more, then either cancel_wait()s or wait()s on the returned key. A producer
+// calls notify_one() after publishing; when nobody is registered that is a
+// fence and a load of the waiter count. The fences on both sides order each
+// side's store before its load whatever ordering the structure itself uses,
+// so the consumer sees the publish or the producer sees the waiter. Waiters
+// sleep on the epoch word, which notify bumps before waking them.
+class eventcount {
+public:
+    typedef uint32_t key_t;
+    
+    inline key_t prepare_wait() {
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return epoch.load(std::memory_order_seq_cst);
+    }
+    
+    inline void cancel_wait() {
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+    
+    // sleeps until notified after prepare_wait() returned key
+    void wait(key_t key) {
+        wait_for(key, -1);
+    }
+    
+    // returns false on timeout (timeout_ns < 0 : infinite)
+    bool wait_for(key_t key, int64_t timeout_ns) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(timeout_ns);
+        bool notified = true;
+        while(epoch.load(std::memory_order_acquire) == key) {
+            int64_t remaining_ns = -1;
+            if(timeout_ns >= 0) {
+                remaining_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now()).count();
+                if(remaining_ns <= 0) {
+                    notified = false;
+                    break;
+                }
+            }
+#if SUPPORTS_PLATFORM_FUTEX
+            platform::platform_futex_wait(&epoch, key, remaining_ns);
+#else
+            std::this_thread::yield();
+#endif
+        }
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+        return notified;
+    }
+    
+    inline void notify_one() {
+        // pairs with the fence of prepare_wait(), even after a release-only publish
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(waiters.load(std::memory_order_relaxed) != 0)
+            notify_slow(false);
+    }
+    
+    inline void notify_all() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(waiters.load(std::memory_order_relaxed) != 0)
+            notify_slow(true);
+    }
+    
+private:
+    void notify_slow(bool all) {
+        epoch.fetch_add(1, std::memory_order_seq_cst);
+#if SUPPORTS_PLATFORM_FUTEX
+        if(all)
+            platform::platform_futex_wake_all(&epoch);
+        else
+            platform::platform_futex_wake_one(&epoch);
+#else
+        (void)all;
+#endif
+    }
+    
+private:
+    alignas(64) std::atomic<uint32_t> waiters{0};
+    std::atomic<uint32_t> epoch{0};
+};
+
+// lock-free stack with blocking pops
+//
+// push() and pop() are the ones of the underlying stack plus the notify
+// check; pop_wait() sleeps on an eventcount instead of spinning on pop().
+template<typename T, typename stack_t = lf_stack<T>>
+class lf_blocking_stack {
+public:
+    void push(const T &value) {
+        stack.push(value);
+        event.notify_one();
+    }
+    
+    bool pop(T &out_value) {
+        return stack.pop(out_value);
+    }
+    
+    void pop_wait(T &out_value) {
+        while(!stack.pop(out_value)) {
+            eventcount::key_t key = event.prepare_wait();
+            if(stack.pop(out_value)) {
+                event.cancel_wait();
+                return;
+            }
+            event.wait(key);
+        }
+    }
+    
+    // returns false if the stack stayed empty for timeout_ns
+    bool pop_wait_for(T &out_value, int64_t timeout_ns) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(timeout_ns);
+        while(!stack.pop(out_value)) {
+            eventcount::key_t key = event.prepare_wait();
+            if(stack.pop(out_value)) {
+                event.cancel_wait();
+                return true;
+            }
+            int64_t remaining_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now()).count();
+            if(remaining_ns <= 0) {
+                event.cancel_wait();
+                return false;
+            }
+            event.wait_for(key, remaining_ns);
+        }
+        return true;
+    }
+    
+private:
+    stack_t stack;
+    eventcount event;
+};
+
+#endif /* EventCount_h */
@@ -0,0 +1,161 @@
+//
+//  FlatCombining.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef FlatCombining_h
+#define FlatCombining_h
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "Mutex.h"
+#include "../Thread/ThreadLocal.h"
+#include "../../Platform/PlatformDefine.h"
+
+// number of publication slots (must be power of 2)
+#define FLAT_COMBINING_SLOT_COUNT 128
+
+// number of scans over the slots per combining pass
+#define FLAT_COMBINING_SCAN_COUNT 2
+
+// pauses a publisher waits for a combiner before blocking on the lock
+#define FLAT_COMBINING_SPIN_COUNT 256
+
+// Flat combining (Hendler, Incze, Shavit, Tzafrir)
+//
+// Wraps a sequential object. A thread publishes its operation in a slot
+// and spins on that slot only; whoever wins the try_lock becomes the
+// combiner and applies every pending operation in one pass, so the object
+// and the lock stay in the combiner's cache instead of bouncing between
+// threads. Slots are claimed per operation, starting from the thread id.
+template<typename T>
+class flat_combining {
+public:
+    template<typename... args_t>
+    flat_combining(args_t&&... args) : object(std::forward<args_t>(args)...) {}
+    
+    flat_combining(const flat_combining&) = delete;
+    flat_combining& operator=(const flat_combining&) = delete;
+    
+public:
+    // runs func(T&) under mutual exclusion and returns its result
+    template<typename func_t>
+    auto apply(func_t func) -> decltype(func(std::declval<T&>())) {
+        typedef decltype(func(std::declval<T&>())) result_t;
+        if constexpr (std::is_void<result_t>::value) {
+            operation_t<func_t, char> operation{ &func };
+            execute(&operation, &operation_t<func_t, char>::invoke_void);
+        }
+        else {
+            operation_t<func_t, result_t> operation{ &func };
+            execute(&operation, &operation_t<func_t, result_t>::invoke);
+            return std::move(operation.result);
+        }
+    }
+    
+    // direct access, only while no other thread calls apply()
+    T &debug_object() { return object; }
+    
+private:
+    typedef void (*invoke_t)(T&, void*);
+    
+    template<typename func_t, typename result_t>
+    struct operation_t {
+        func_t *func;
+        result_t result{};
+        
+        static void invoke(T &object, void *context) {
+            operation_t *operation = (operation_t*)context;
+            operation->result = (*operation->func)(object);
+        }
+        
+        static void invoke_void(T &object, void *context) {
+            (*((operation_t*)context)->func)(object);
+        }
+    };
+    
+    // slot states
+    static constexpr uint32_t SLOT_FREE = 0;
+    static constexpr uint32_t SLOT_CLAIMED = 1;
+    static constexpr uint32_t SLOT_PENDING = 2;
+    static constexpr uint32_t SLOT_DONE = 3;
+    
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) slot_t {
+        std::atomic<uint32_t> state{SLOT_FREE};
+        invoke_t invoke = nullptr;
+        void *context = nullptr;
+    };
+    
+private:
+    void execute(void *context, invoke_t invoke) {
+        slot_t &slot = claim_slot();
+        slot.invoke = invoke;
+        slot.context = context;
+        slot.state.store(SLOT_PENDING, std::memory_order_release);
+        
+        int spins = 0;
+        while(slot.state.load(std::memory_order_acquire) != SLOT_DONE) {
+            if(mutex.try_lock()) {
+                combine();
+                mutex.unlock();
+            }
+            else if(++spins < FLAT_COMBINING_SPIN_COUNT) {
+                spin_pause();
+            }
+            else {
+                // the combiner may be preempted, park on the lock and combine ourselves
+                mutex.lock();
+                if(slot.state.load(std::memory_order_acquire) != SLOT_DONE)
+                    combine();
+                mutex.unlock();
+            }
+        }
+        slot.state.store(SLOT_FREE, std::memory_order_release);
+    }
+    
+    slot_t &claim_slot() {
+        uint32_t index = threadlocal_get_thread_id() & (FLAT_COMBINING_SLOT_COUNT - 1);
+        spin_wait waiter;
+        for(;;) {
+            // another thread with the same home slot may be using it, probe the next ones
+            for(uint32_t probe = 0; probe < FLAT_COMBINING_SLOT_COUNT; probe++, index = (index + 1) & (FLAT_COMBINING_SLOT_COUNT - 1)) {
+                uint32_t expected = SLOT_FREE;
+                if(slots[index].state.load(std::memory_order_relaxed) == SLOT_FREE &&
+                   slots[index].state.compare_exchange_strong(expected, SLOT_CLAIMED, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    uint32_t used = used_slot_count.load(std::memory_order_relaxed);
+                    while(used <= index && !used_slot_count.compare_exchange_weak(used, index + 1, std::memory_order_release, std::memory_order_relaxed));
+                    return slots[index];
+                }
+            }
+            waiter.wait();
+        }
+    }
+    
+    // applies every pending operation (called with the mutex held)
+    void combine() {
+        for(uint32_t scan = 0; scan < FLAT_COMBINING_SCAN_COUNT; scan++) {
+            uint32_t used = used_slot_count.load(std::memory_order_acquire);
+            for(uint32_t i = 0; i < used; i++) {
+                slot_t &slot = slots[i];
+                if(slot.state.load(std::memory_order_acquire) != SLOT_PENDING)
+                    continue;
+                slot.invoke(object, slot.context);
+                slot.state.store(SLOT_DONE, std::memory_order_release);
+            }
+        }
+    }
+    
+private:
+    alignas(PLATFORM_CACHE_LINE_SIZE) spinlock_mutex mutex;
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32_t> used_slot_count{0};
+    alignas(PLATFORM_CACHE_LINE_SIZE) T object;
+    slot_t slots[FLAT_COMBINING_SLOT_COUNT];
+    
+    static_assert((FLAT_COMBINING_SLOT_COUNT & (FLAT_COMBINING_SLOT_COUNT - 1)) == 0, "The slot count must be power of 2!");
+};
+
+#endif /* FlatCombining_h */
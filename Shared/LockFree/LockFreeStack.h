@@ -11,6 +11,7 @@
 #include <atomic>
 #include <memory>
 #include <utility>
+#include "../Thread/Tracer.h"
 #include "../../Option/Option.h"
 
 // for checking memory leaks of nodes...
@@ -19,12 +20,13 @@
 #endif
 
 #if DEBUG_ALIVE_NODE_COUNT
-inline static std::atomic<int32_t> debug_alive_node_count{0};
-#define INC_ALIVE_NODE_COUNT debug_alive_node_count.fetch_add(1, std::memory_order_relaxed)
-#define DEC_ALIVE_NODE_COUNT debug_alive_node_count.fetch_add(-1, std::memory_order_relaxed)
+#include "ShardedCounter.h"
+inline sharded_counter debug_alive_node_count;
+#define INC_ALIVE_NODE_COUNT debug_alive_node_count.add(1)
+#define DEC_ALIVE_NODE_COUNT debug_alive_node_count.add(-1)
 #define STAT_ALIVE_NODE_COUNT \
 {\
-int32_t val = debug_alive_node_count.load(std::memory_order_seq_cst);\
+int64_t val = debug_alive_node_count.read();\
 std::cout << "active node count is " << val << std::endl;\
 }
 #else
@@ -56,7 +58,9 @@ public:
         link.ptr = (uintptr_t)n;
         link.counter = 1;
         n->next = head.load();
-        while(!head.compare_exchange_strong(n->next, link));
+        while(!head.compare_exchange_strong(n->next, link)) {
+            TRACE_INSTANT("lf_stack push cas retry");
+        }
     }
 
     bool pop(T &out_value) {
@@ -64,11 +68,13 @@ public:
         node_link_t prev_head = head.load();
         
         for(;;) {
-            do {
+            for(;;) {
                 link = prev_head;
                 link.counter++;
+                if(head.compare_exchange_strong(prev_head, link))
+                    break;
+                TRACE_INSTANT("lf_stack pop cas retry");
             }
-            while(!head.compare_exchange_strong(prev_head, link));
             
             if(prev_head.ptr == 0) {
                 return false;
@@ -85,6 +91,7 @@ public:
             else if(node->ref_count.fetch_sub(1) == 1) {
                 delete node;
             }
+            TRACE_INSTANT("lf_stack pop unlink cas retry");
         }
     }
     
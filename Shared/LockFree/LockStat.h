@@ -0,0 +1,298 @@
+//
+//  LockStat.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef LockStat_h
+#define LockStat_h
+
+#include "../../Option/Option.h"
+
+#if USE_LOCK_STAT
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// number of log2(ns) buckets of wait/hold time histograms
+#define LOCK_STAT_HISTOGRAM_SIZE 32
+
+// number of distinct locks tracked per thread (must be power of 2)
+#define LOCK_STAT_TABLE_SIZE 256
+
+inline uint64_t lock_stat_now() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// histogram bucket i holds durations in [2^(i-1), 2^i) ns
+inline uint32_t lock_stat_bucket(uint64_t ns) {
+    uint32_t bucket = 0;
+#if __GNUC__
+    bucket = ns == 0 ? 0 : 64 - __builtin_clzll(ns);
+#else
+    while(ns != 0) {
+        ns >>= 1;
+        bucket++;
+    }
+#endif
+    return bucket < LOCK_STAT_HISTOGRAM_SIZE ? bucket : LOCK_STAT_HISTOGRAM_SIZE - 1;
+}
+
+// merged statistics of a lock (or of every lock sharing a name)
+struct lock_stat_summary {
+    std::string name;
+    uint64_t acquisitions = 0;
+    uint64_t contended = 0;
+    uint64_t spins = 0;
+    uint64_t wait_ns = 0;
+    uint64_t hold_ns = 0;
+    uint64_t wait_histogram[LOCK_STAT_HISTOGRAM_SIZE] = {};
+    uint64_t hold_histogram[LOCK_STAT_HISTOGRAM_SIZE] = {};
+    
+    // upper bound (ns) of the bucket containing the percentile (0 ~ 1)
+    static uint64_t percentile(const uint64_t *histogram, uint64_t total, double p) {
+        uint64_t rank = (uint64_t)(p * total);
+        uint64_t seen = 0;
+        for(uint32_t i = 0; i < LOCK_STAT_HISTOGRAM_SIZE; i++) {
+            seen += histogram[i];
+            if(seen > rank)
+                return i == 0 ? 0 : (uint64_t(1) << i);
+        }
+        return uint64_t(1) << (LOCK_STAT_HISTOGRAM_SIZE - 1);
+    }
+    
+    uint64_t wait_percentile(double p) const { return percentile(wait_histogram, acquisitions, p); }
+    uint64_t hold_percentile(double p) const { return percentile(hold_histogram, acquisitions, p); }
+};
+
+// Lock contention statistics (lockstat)
+//
+// Every thread writes into its own table of per-lock records, so profiling
+// adds no shared writes to the locks. Counters are relaxed atomics written
+// by the owning thread only; report() merges all tables by lock name.
+class lock_stat_registry {
+public:
+    lock_stat_registry() : buffers(nullptr) {}
+    
+    ~lock_stat_registry() {
+        lock_stat_buffer_t *buffer = buffers.load();
+        while(buffer != nullptr) {
+            lock_stat_buffer_t *next = buffer->next;
+            delete buffer;
+            buffer = next;
+        }
+    }
+    
+    // one lock/unlock cycle, called by the owner before it releases the lock
+    void record(const void *lock, const char *name, uint64_t wait_ns, uint64_t hold_ns, bool contended, uint64_t spins) {
+        record_t *rec = get_buffer()->find_or_add(lock, name);
+        add(rec->acquisitions, 1);
+        if(contended) {
+            add(rec->contended, 1);
+            add(rec->spins, spins);
+        }
+        add(rec->wait_ns, wait_ns);
+        add(rec->hold_ns, hold_ns);
+        add(rec->wait_histogram[lock_stat_bucket(wait_ns)], 1);
+        add(rec->hold_histogram[lock_stat_bucket(hold_ns)], 1);
+    }
+    
+    // top-N locks ordered by contended acquisitions, then by total wait time
+    std::vector<lock_stat_summary> report(size_t top_n) {
+        std::map<std::string, lock_stat_summary> merged;
+        for(lock_stat_buffer_t *buffer = buffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->next) {
+            for(size_t i = 0; i < LOCK_STAT_TABLE_SIZE + 1; i++) {
+                record_t *rec = buffer->records[i].load(std::memory_order_acquire);
+                if(rec == nullptr)
+                    continue;
+                
+                std::string key = get_name(rec);
+                lock_stat_summary &summary = merged[key];
+                summary.name = key;
+                summary.acquisitions += rec->acquisitions.load(std::memory_order_relaxed);
+                summary.contended += rec->contended.load(std::memory_order_relaxed);
+                summary.spins += rec->spins.load(std::memory_order_relaxed);
+                summary.wait_ns += rec->wait_ns.load(std::memory_order_relaxed);
+                summary.hold_ns += rec->hold_ns.load(std::memory_order_relaxed);
+                for(uint32_t k = 0; k < LOCK_STAT_HISTOGRAM_SIZE; k++) {
+                    summary.wait_histogram[k] += rec->wait_histogram[k].load(std::memory_order_relaxed);
+                    summary.hold_histogram[k] += rec->hold_histogram[k].load(std::memory_order_relaxed);
+                }
+            }
+        }
+        
+        std::vector<lock_stat_summary> result;
+        result.reserve(merged.size());
+        for(auto &item : merged)
+            result.push_back(item.second);
+        std::sort(result.begin(), result.end(), [](const lock_stat_summary &a, const lock_stat_summary &b) {
+            return a.contended != b.contended ? a.contended > b.contended : a.wait_ns > b.wait_ns;
+        });
+        if(result.size() > top_n)
+            result.resize(top_n);
+        return result;
+    }
+    
+    void print(std::ostream &os, size_t top_n) {
+        std::vector<lock_stat_summary> summaries = report(top_n);
+        os << "lockstat (top " << top_n << " contended locks)" << std::endl;
+        for(const lock_stat_summary &s : summaries) {
+            os << "  " << s.name << ":"
+               << " acquisitions " << s.acquisitions
+               << ", contended " << s.contended << " (" << (s.acquisitions > 0 ? 100.0 * s.contended / s.acquisitions : 0) << "%)"
+               << ", spins " << s.spins
+               << ", wait total " << (s.wait_ns / 1000) << " us (p50 < " << s.wait_percentile(0.5) << " ns, p99 < " << s.wait_percentile(0.99) << " ns)"
+               << ", hold total " << (s.hold_ns / 1000) << " us (p50 < " << s.hold_percentile(0.5) << " ns, p99 < " << s.hold_percentile(0.99) << " ns)"
+               << std::endl;
+        }
+    }
+    
+private:
+    struct record_t {
+        const void *lock;
+        std::atomic<const char*> name;
+        std::atomic<uint64_t> acquisitions{0};
+        std::atomic<uint64_t> contended{0};
+        std::atomic<uint64_t> spins{0};
+        std::atomic<uint64_t> wait_ns{0};
+        std::atomic<uint64_t> hold_ns{0};
+        std::atomic<uint64_t> wait_histogram[LOCK_STAT_HISTOGRAM_SIZE] = {};
+        std::atomic<uint64_t> hold_histogram[LOCK_STAT_HISTOGRAM_SIZE] = {};
+        
+        record_t(const void *in_lock, const char *in_name) : lock(in_lock), name(in_name) {}
+    };
+    
+    // per-thread open addressing table keyed by lock address (last slot collects overflow)
+    struct lock_stat_buffer_t {
+        std::atomic<record_t*> records[LOCK_STAT_TABLE_SIZE + 1] = {};
+        std::atomic<bool> in_use{true};
+        lock_stat_buffer_t *next = nullptr;
+        
+        ~lock_stat_buffer_t() {
+            for(size_t i = 0; i < LOCK_STAT_TABLE_SIZE + 1; i++)
+                delete records[i].load(std::memory_order_relaxed);
+        }
+        
+        record_t *find_or_add(const void *lock, const char *name) {
+            size_t index = (size_t)(((uintptr_t)lock >> 4) * 0x9E3779B97F4A7C15ull >> 32) & (LOCK_STAT_TABLE_SIZE - 1);
+            for(size_t probe = 0; probe < LOCK_STAT_TABLE_SIZE; probe++, index = (index + 1) & (LOCK_STAT_TABLE_SIZE - 1)) {
+                record_t *rec = records[index].load(std::memory_order_relaxed);
+                if(rec == nullptr) {
+                    rec = new record_t(lock, name);
+                    records[index].store(rec, std::memory_order_release);
+                    return rec;
+                }
+                if(rec->lock == lock) {
+                    // locks may be named after their first acquisition
+                    if(rec->name.load(std::memory_order_relaxed) != name)
+                        rec->name.store(name, std::memory_order_relaxed);
+                    return rec;
+                }
+            }
+            
+            record_t *overflow = records[LOCK_STAT_TABLE_SIZE].load(std::memory_order_relaxed);
+            if(overflow == nullptr) {
+                overflow = new record_t(nullptr, "(overflow)");
+                records[LOCK_STAT_TABLE_SIZE].store(overflow, std::memory_order_release);
+            }
+            return overflow;
+        }
+    };
+    
+    // binds a buffer to the current thread, released on thread exit
+    class threadlocal_buffer_t {
+    public:
+        threadlocal_buffer_t() : owner(nullptr), buffer(nullptr) {}
+        
+        ~threadlocal_buffer_t() {
+            if(buffer != nullptr) {
+                // the statistics stay in the buffer for its next owner
+                buffer->in_use.store(false, std::memory_order_release);
+            }
+        }
+        
+        lock_stat_registry *owner;
+        lock_stat_buffer_t *buffer;
+    };
+    
+    inline static thread_local threadlocal_buffer_t threadlocal_buffer;
+    
+private:
+    static inline void add(std::atomic<uint64_t> &counter, uint64_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+    
+    static std::string get_name(record_t *rec) {
+        const char *name = rec->name.load(std::memory_order_relaxed);
+        if(name != nullptr)
+            return name;
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "lock@%p", rec->lock);
+        return buffer;
+    }
+    
+    lock_stat_buffer_t *get_buffer() {
+        threadlocal_buffer_t &tls = threadlocal_buffer;
+        if(tls.owner == this)
+            return tls.buffer;
+        
+        lock_stat_buffer_t *buffer = buffers.load(std::memory_order_acquire);
+        for(; buffer != nullptr; buffer = buffer->next) {
+            bool expected = false;
+            if(!buffer->in_use.load(std::memory_order_relaxed) && buffer->in_use.compare_exchange_strong(expected, true))
+                break;
+        }
+        if(buffer == nullptr) {
+            buffer = new lock_stat_buffer_t();
+            buffer->next = buffers.load(std::memory_order_relaxed);
+            while(!buffers.compare_exchange_weak(buffer->next, buffer, std::memory_order_release, std::memory_order_relaxed));
+        }
+        tls.owner = this;
+        tls.buffer = buffer;
+        return buffer;
+    }
+    
+private:
+    std::atomic<lock_stat_buffer_t*> buffers;
+};
+
+inline lock_stat_registry global_lock_stat;
+
+// profiling state embedded in a lock (only touched by the lock owner)
+struct lock_stat_site {
+    const char *name = nullptr;
+    uint64_t acquired_at = 0;
+    uint64_t wait_ns = 0;
+    uint64_t spins = 0;
+    bool contended = false;
+    
+    inline void on_acquire() {
+        acquired_at = lock_stat_now();
+        wait_ns = 0;
+        spins = 0;
+        contended = false;
+    }
+    
+    inline void on_contended_acquire(uint64_t wait_begin, uint64_t num_spins) {
+        acquired_at = lock_stat_now();
+        wait_ns = acquired_at - wait_begin;
+        spins = num_spins;
+        contended = true;
+    }
+    
+    inline void on_release(const void *lock) {
+        global_lock_stat.record(lock, name, wait_ns, lock_stat_now() - acquired_at, contended, spins);
+    }
+};
+
+#endif
+
+#endif /* LockStat_h */
@@ -0,0 +1,101 @@
+//
+//  MPSCQueue.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef MPSCQueue_h
+#define MPSCQueue_h
+
+#include <atomic>
+#include <cstddef>
+
+// hook embedded in the items of intrusive_mpsc_queue
+struct mpsc_queue_hook {
+    std::atomic<mpsc_queue_hook*> next{nullptr};
+};
+
+// Intrusive multi-producer single-consumer queue (Vyukov)
+//
+// T must derive from mpsc_queue_hook. push() is wait-free and allocates
+// nothing; the caller keeps the ownership of the item until it is popped.
+// pop() and drain() must be called from a single consumer thread at a time.
+template<typename T>
+class intrusive_mpsc_queue {
+public:
+    intrusive_mpsc_queue() : head(&stub), tail(&stub) {}
+
+    ~intrusive_mpsc_queue() {}
+
+    intrusive_mpsc_queue(const intrusive_mpsc_queue&) = delete;
+    intrusive_mpsc_queue& operator=(const intrusive_mpsc_queue&) = delete;
+
+public:
+    // wait-free, callable from any thread
+    void push(T *item) {
+        push_hook(static_cast<mpsc_queue_hook*>(item));
+    }
+
+    // returns nullptr when the queue is empty, or when the next item is still
+    // being pushed (its producer has swapped the tail but not linked it yet).
+    T *pop() {
+        mpsc_queue_hook *h = head;
+        mpsc_queue_hook *next = h->next.load(std::memory_order_acquire);
+        if(h == &stub) {
+            if(next == nullptr)
+                return nullptr;
+            head = next;
+            h = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if(next != nullptr) {
+            head = next;
+            return static_cast<T*>(h);
+        }
+
+        if(h != tail.load(std::memory_order_acquire))
+            return nullptr;
+
+        // h is the last item, put the stub behind it to detach it
+        push_hook(&stub);
+        next = h->next.load(std::memory_order_acquire);
+        if(next != nullptr) {
+            head = next;
+            return static_cast<T*>(h);
+        }
+        return nullptr;
+    }
+
+    // pops every available item and calls func(T*) for each, returns the count
+    template<typename func_t>
+    size_t drain(func_t func) {
+        size_t count = 0;
+        while(T *item = pop()) {
+            func(item);
+            count++;
+        }
+        return count;
+    }
+
+    // consumer-side check (a concurrent push may not be visible yet)
+    bool empty() {
+        return head == &stub && stub.next.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    inline void push_hook(mpsc_queue_hook *h) {
+        h->next.store(nullptr, std::memory_order_relaxed);
+        mpsc_queue_hook *prev = tail.exchange(h, std::memory_order_acq_rel);
+        prev->next.store(h, std::memory_order_release);
+    }
+
+private:
+    // consumer side
+    alignas(64) mpsc_queue_hook *head;
+    mpsc_queue_hook stub;
+    // producer side
+    alignas(64) std::atomic<mpsc_queue_hook*> tail;
+};
+
+#endif /* MPSCQueue_h */
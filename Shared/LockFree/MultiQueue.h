@@ -0,0 +1,225 @@
+//
+//  MultiQueue.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef MultiQueue_h
+#define MultiQueue_h
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Mutex.h"
+#include "../Thread/ThreadLocal.h"
+#include "../../Option/Option.h"
+#include "../../Platform/PlatformDefine.h"
+
+#if USE_MEMORY_POOL
+#include "../Memory/MemoryPool.h"
+#endif
+
+// number of heaps per thread (the c of c x P)
+#define MULTI_QUEUE_HEAPS_PER_THREAD 2
+
+// failed two-choice picks of pop() before scanning every heap
+#define MULTI_QUEUE_POP_ATTEMPTS 8
+
+// top priority of an empty heap
+#define MULTI_QUEUE_EMPTY UINT64_MAX
+
+// per-thread xorshift state of the random heap picks
+inline thread_local uint64_t __tls_multi_queue_random = 0;
+
+// Relaxed concurrent priority queue (MultiQueue, Rihani/Sanders/Dementiev)
+//
+// c x P binary heaps, each behind a spinlock_mutex that is only ever
+// try-locked. push() goes to a random heap; pop() peeks the cached tops
+// of two random heaps and takes the smaller one. The popped element is
+// not always the global minimum, but its expected rank is O(c x P) and
+// independent of the queue size, and threads rarely meet on a lock.
+// Priorities are 64-bit with the smallest first (deadlines for timed
+// work). Values live in separate nodes, taken from global_memory_pool when
+// USE_MEMORY_POOL is set (like lf_stack's), from operator new otherwise.
+template<typename V>
+class multi_queue {
+public:
+    // num_threads = 0 : hardware concurrency
+    multi_queue(uint32_t num_threads = 0, uint32_t heaps_per_thread = MULTI_QUEUE_HEAPS_PER_THREAD) {
+        if(num_threads == 0)
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
+        num_heaps = std::max(2u, num_threads * heaps_per_thread);
+        heaps = new heap_t[num_heaps];
+        for(uint32_t i = 0; i < num_heaps; i++)
+            heaps[i].mutex.set_lock_name("multi_queue heap");
+    }
+
+    // must not be called while other threads still use the queue
+    ~multi_queue() {
+        for(uint32_t i = 0; i < num_heaps; i++) {
+            for(entry_t &entry : heaps[i].entries)
+                delete entry.node;
+        }
+        delete[] heaps;
+    }
+
+    multi_queue(const multi_queue&) = delete;
+    multi_queue& operator=(const multi_queue&) = delete;
+
+public:
+    void push(uint64_t priority, const V &value) {
+        node_t *node = new node_t(value);
+        for(;;) {
+            heap_t &heap = heaps[get_random_index()];
+            if(!heap.mutex.try_lock())
+                continue;
+            heap.entries.push_back({ priority, node });
+            std::push_heap(heap.entries.begin(), heap.entries.end(), entry_greater_t());
+            heap.update_top();
+            heap.mutex.unlock();
+            return;
+        }
+    }
+
+    // pops an element of a small rank whose priority is <= max_priority
+    // (returns false when no heap has one, checked over every heap)
+    bool pop(uint64_t &out_priority, V &out_value, uint64_t max_priority = MULTI_QUEUE_EMPTY - 1) {
+        for(int attempt = 0; attempt < MULTI_QUEUE_POP_ATTEMPTS; attempt++) {
+            // two different heaps, a heap compared with itself drifts away from the others
+            uint32_t first = get_random_index();
+            uint32_t second = get_random_index();
+            if(second == first)
+                second = first + 1 < num_heaps ? first + 1 : 0;
+            uint64_t first_top = heaps[first].top.load(std::memory_order_relaxed);
+            uint64_t second_top = heaps[second].top.load(std::memory_order_relaxed);
+            uint32_t index = second_top < first_top ? second : first;
+            if(std::min(first_top, second_top) > max_priority)
+                continue;
+            if(try_pop_heap(heaps[index], max_priority, out_priority, out_value))
+                return true;
+        }
+
+        // nothing found by sampling, the queue may be (nearly) empty
+        for(;;) {
+            bool found = false;
+            for(uint32_t i = 0; i < num_heaps; i++) {
+                if(heaps[i].top.load(std::memory_order_relaxed) > max_priority)
+                    continue;
+                found = true;
+                if(try_pop_heap(heaps[i], max_priority, out_priority, out_value))
+                    return true;
+            }
+            if(!found)
+                return false;
+            std::this_thread::yield();
+        }
+    }
+
+    // racy, a hint only
+    bool empty() const {
+        for(uint32_t i = 0; i < num_heaps; i++) {
+            if(heaps[i].top.load(std::memory_order_relaxed) != MULTI_QUEUE_EMPTY)
+                return false;
+        }
+        return true;
+    }
+
+    // approximate element count (exact when no thread is running)
+    size_t size() const {
+        size_t total = 0;
+        for(uint32_t i = 0; i < num_heaps; i++)
+            total += heaps[i].count.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    inline uint32_t get_heap_count() const { return num_heaps; }
+
+private:
+    // internal node structure (the value stays out of the heap arrays)
+    struct node_t {
+        V value;
+
+        node_t(const V &new_value) : value(new_value) {}
+
+#if USE_MEMORY_POOL
+        static void *operator new(size_t size) {
+            if constexpr (sizeof(node_t) <= BLOCK_SIZE_LIST[NUM_BLOCK_SIZE - 1])
+                return global_memory_pool.allocate(size);
+            else
+                return ::operator new(size);
+        }
+
+        static void operator delete(void *ptr) {
+            if constexpr (sizeof(node_t) <= BLOCK_SIZE_LIST[NUM_BLOCK_SIZE - 1])
+                global_memory_pool.free(ptr);
+            else
+                ::operator delete(ptr);
+        }
+#endif
+    };
+
+    struct entry_t {
+        uint64_t priority;
+        node_t *node;
+    };
+
+    // min-heap order for the std heap functions
+    struct entry_greater_t {
+        inline bool operator()(const entry_t &a, const entry_t &b) const { return a.priority > b.priority; }
+    };
+
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) heap_t {
+        spinlock_mutex mutex;
+        // read without the lock by pop() to pick a heap
+        std::atomic<uint64_t> top{MULTI_QUEUE_EMPTY};
+        std::atomic<size_t> count{0};
+        std::vector<entry_t> entries;
+
+        inline void update_top() {
+            top.store(entries.empty() ? MULTI_QUEUE_EMPTY : entries.front().priority, std::memory_order_relaxed);
+            count.store(entries.size(), std::memory_order_relaxed);
+        }
+    };
+
+private:
+    bool try_pop_heap(heap_t &heap, uint64_t max_priority, uint64_t &out_priority, V &out_value) {
+        if(!heap.mutex.try_lock())
+            return false;
+        if(heap.entries.empty() || heap.entries.front().priority > max_priority) {
+            heap.mutex.unlock();
+            return false;
+        }
+        std::pop_heap(heap.entries.begin(), heap.entries.end(), entry_greater_t());
+        entry_t entry = heap.entries.back();
+        heap.entries.pop_back();
+        heap.update_top();
+        heap.mutex.unlock();
+
+        out_priority = entry.priority;
+        out_value = std::move(entry.node->value);
+        delete entry.node;
+        return true;
+    }
+
+    inline uint32_t get_random_index() {
+        uint64_t x = __tls_multi_queue_random;
+        if(x == 0)
+            x = 0x9E3779B97F4A7C15ull * (threadlocal_get_thread_id() + 1);
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        __tls_multi_queue_random = x;
+        return (uint32_t)(((x >> 32) * num_heaps) >> 32);
+    }
+
+private:
+    uint32_t num_heaps;
+    heap_t *heaps;
+};
+
+#endif /* MultiQueue_h */
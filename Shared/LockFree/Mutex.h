@@ -9,20 +9,70 @@
 #define Mutex_h
 
 #include <atomic>
+#include <cstdint>
+#include <thread>
+#include "LockStat.h"
+#include "../Thread/Tracer.h"
+#include "../Thread/ThreadLocal.h"
+#include "../../Option/Option.h"
+#include "../../Platform/PlatformDefine.h"
+#include "../../Platform/PlatformFutex.h"
 
 // number of spins
 #define DEFAULT_SPIN_COUNT 512
 
+// number of reader counter slots in rw_spinlock_mutex (must be power of 2)
+#define RW_LOCK_READER_SLOTS 64
+
+// upper bound of the exponential backoff (in pause instructions)
+#define MAX_SPIN_BACKOFF 64
+
 // flag to use x64 BTS assembly in GCC/Clang (12~20% faster than XCHG!)
 #define USE_GCC_ASSEMBLY_X64_BTS (__x86_64__ && __GNUC__)
 
 // flag to use x64 BTS assembly in MSVC (12~20% faster than XCHG!)
 #define USE_MSVC_ASSEMBLY_X64_BTS (_M_X64 && _MSC_VER)
 
-#if USE_MSVC_ASSEMBLY_X64_BTS
+#if _MSC_VER
 #include <intrin.h>
 #endif
 
+// hint to the cpu that we are in a spin-wait loop
+inline void spin_pause() {
+#if (__x86_64__ || __i386__) && __GNUC__
+    __builtin_ia32_pause();
+#elif (_M_X64 || _M_IX86) && _MSC_VER
+    _mm_pause();
+#elif __aarch64__ && __GNUC__
+    asm volatile("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// pause-based spin wait that gives up the time slice every spin_count pauses
+class spin_wait {
+public:
+    spin_wait(int new_spin_count = DEFAULT_SPIN_COUNT) : spin_count(new_spin_count), spins(0), total_spins(0) {}
+    
+    inline void wait() {
+        spin_pause();
+        total_spins++;
+        if(++spins >= spin_count) {
+            spins = 0;
+            std::this_thread::yield();
+        }
+    }
+    
+    // number of wait() calls so far
+    inline uint64_t get_total_spins() const { return total_spins; }
+    
+private:
+    int spin_count;
+    int spins;
+    uint64_t total_spins;
+};
+
 // scoped lock
 template<typename mutex_t>
 class scoped_lock {
@@ -34,62 +84,513 @@ private:
     mutex_t *mutex;
 };
 
-// spinlock mutex
+// scoped shared lock
+template<typename mutex_t>
+class scoped_read_lock {
+public:
+    scoped_read_lock(mutex_t *in_mutex) : mutex(in_mutex) { mutex->lock_shared(); }
+    ~scoped_read_lock() { mutex->unlock_shared(); }
+    
+private:
+    mutex_t *mutex;
+};
+
+// spinlock mutex (adaptive spin-then-park)
+//
+// The uncontended path is a single BTS. A contended lock() spins with
+// exponential pause backoff for a number of iterations learned from
+// previous acquisitions (bounded by spin_count), then parks on a futex.
 class spinlock_mutex {
 public:
-    spinlock_mutex(int new_spin_count = DEFAULT_SPIN_COUNT) : spin_count(new_spin_count) {}
+    spinlock_mutex(int new_spin_count = DEFAULT_SPIN_COUNT) : spin_count(new_spin_count), learned_spin_count(new_spin_count / 8) {}
+    
+    // names the lock in lockstat reports (no-op unless USE_LOCK_STAT)
+    inline void set_lock_name(const char *name) {
+#if USE_LOCK_STAT
+        stat.name = name;
+#endif
+        (void)name;
+    }
     
     inline void lock() {
 #if USE_GCC_ASSEMBLY_X64_BTS
-        mutex_try:
         uint8_t ret;
-        asm (
+        asm volatile (
             "lock btsl $0, %0\n\t"
             "setb %1\n\t"
             : "+m" (flag), "=r" (ret)
+            :
+            : "memory", "cc"
         );
-        
-        if(ret) {
 #elif USE_MSVC_ASSEMBLY_X64_BTS
-        mutex_try:
-        uint8_t ret = _interlockedbittestandset(&flag, 0);
-        
+        uint8_t ret = _interlockedbittestandset((volatile long*)&flag, 0);
+#else
+        bool ret = (flag.fetch_or(LOCKED, std::memory_order_acquire) & LOCKED) != 0;
+#endif
+#if USE_LOCK_STAT
         if(ret) {
+            TRACE_LOCK_WAIT("spinlock_mutex", this);
+            uint64_t wait_begin = lock_stat_now();
+            stat.on_contended_acquire(wait_begin, lock_contended());
+            TRACE_LOCK_ACQUIRE("spinlock_mutex", this);
+        }
+        else {
+            stat.on_acquire();
+        }
 #else
-        while(flag.test_and_set(std::memory_order_seq_cst)) {
+        if(ret) {
+            TRACE_LOCK_WAIT("spinlock_mutex", this);
+            lock_contended();
+            TRACE_LOCK_ACQUIRE("spinlock_mutex", this);
+        }
 #endif
-            for(int i = 0; i < spin_count; i++) {
-                std::this_thread::yield();
+    }
+    
+    inline bool try_lock() {
+        uint32_t expected = 0;
+        bool acquired = flag.compare_exchange_strong(expected, LOCKED, std::memory_order_acquire, std::memory_order_relaxed);
+#if USE_LOCK_STAT
+        if(acquired)
+            stat.on_acquire();
+#endif
+        return acquired;
+    }
+    
+    inline void unlock() {
+#if USE_LOCK_STAT
+        stat.on_release(this);
+#endif
+        if(flag.exchange(0, std::memory_order_release) & PARKED) {
+            wake_parked();
+        }
+    }
+    
+private:
+    // lock state bits
+    static constexpr uint32_t LOCKED = 1;
+    static constexpr uint32_t PARKED = 2;
+    
+    // returns the number of pauses spent before acquiring or parking
+    int lock_contended() {
+        // spin budget learned from the recent acquisitions (glibc adaptive mutex style)
+        int learned = learned_spin_count.load(std::memory_order_relaxed);
+        int max_spins = 2 * learned + 16;
+        if(max_spins > spin_count)
+            max_spins = spin_count;
+        
+        int spins = 0;
+        int backoff = 1;
+        while(spins < max_spins) {
+            for(int i = 0; i < backoff; i++)
+                spin_pause();
+            spins += backoff;
+            if(backoff < MAX_SPIN_BACKOFF)
+                backoff <<= 1;
+            
+            // test-and-test-and-set
+            if((flag.load(std::memory_order_relaxed) & LOCKED) == 0 && (flag.fetch_or(LOCKED, std::memory_order_acquire) & LOCKED) == 0) {
+                learned_spin_count.store(learned + (spins - learned) / 8, std::memory_order_relaxed);
+                return spins;
             }
+        }
+        learned_spin_count.store(learned + (max_spins - learned) / 8, std::memory_order_relaxed);
         
-#if USE_GCC_ASSEMBLY_X64_BTS || USE_MSVC_ASSEMBLY_X64_BTS
-            goto mutex_try;
+        // park until the owner releases the lock (the owner wakes us because of PARKED)
+        while(flag.exchange(LOCKED | PARKED, std::memory_order_acquire) & LOCKED) {
+#if SUPPORTS_PLATFORM_FUTEX
+            platform::platform_futex_wait(&flag, LOCKED | PARKED);
+#else
+            std::this_thread::yield();
 #endif
         }
+        return spins;
+    }
+    
+    void wake_parked() {
+#if SUPPORTS_PLATFORM_FUTEX
+        platform::platform_futex_wake_one(&flag);
+#endif
+    }
+    
+private:
+    alignas(64) std::atomic<uint32_t> flag{0};
+    alignas(64) int spin_count;
+    std::atomic<int> learned_spin_count;
+#if USE_LOCK_STAT
+    lock_stat_site stat;
+#endif
+};
+
+// ticket lock (FIFO, waiters spin on the shared now_serving word)
+class ticket_mutex {
+public:
+    ticket_mutex(int new_spin_count = DEFAULT_SPIN_COUNT) : spin_count(new_spin_count) {}
+    
+    // names the lock in lockstat reports (no-op unless USE_LOCK_STAT)
+    inline void set_lock_name(const char *name) {
+#if USE_LOCK_STAT
+        stat.name = name;
+#endif
+        (void)name;
+    }
+    
+    inline void lock() {
+        uint32_t ticket = next_ticket.fetch_add(1, std::memory_order_relaxed);
+        uint32_t serving = now_serving.load(std::memory_order_acquire);
+        if(serving == ticket) {
+#if USE_LOCK_STAT
+            stat.on_acquire();
+#endif
+            return;
+        }
+        
+#if USE_LOCK_STAT
+        uint64_t wait_begin = lock_stat_now();
+#endif
+        spin_wait waiter(spin_count);
+        do {
+            // proportional backoff : the further back in line, the longer we wait
+            for(uint32_t i = 1; i < ticket - serving; i++)
+                spin_pause();
+            waiter.wait();
+            serving = now_serving.load(std::memory_order_acquire);
+        }
+        while(serving != ticket);
+#if USE_LOCK_STAT
+        stat.on_contended_acquire(wait_begin, waiter.get_total_spins());
+#endif
+    }
+    
+    inline bool try_lock() {
+        uint32_t serving = now_serving.load(std::memory_order_acquire);
+        uint32_t ticket = serving;
+        bool acquired = next_ticket.compare_exchange_strong(ticket, serving + 1, std::memory_order_acquire, std::memory_order_relaxed);
+#if USE_LOCK_STAT
+        if(acquired)
+            stat.on_acquire();
+#endif
+        return acquired;
     }
     
     inline void unlock() {
-#if USE_GCC_ASSEMBLY_X64_BTS
-        asm (
-            "lock btrl $0, %0\n\t"
-            : "+m" (flag)
-        );
-#elif USE_MSVC_ASSEMBLY_X64_BTS
-        _InterlockedAnd(&flag, 0);
-#else
-        flag.clear(std::memory_order_seq_cst);
+#if USE_LOCK_STAT
+        stat.on_release(this);
 #endif
+        now_serving.store(now_serving.load(std::memory_order_relaxed) + 1, std::memory_order_release);
     }
     
 private:
-#if USE_GCC_ASSEMBLY_X64_BTS
-    alignas(64) volatile int flag = 0;
-#elif USE_MSVC_ASSEMBLY_X64_BTS
-    alignas(64) volatile long flag = 0;
+    alignas(64) std::atomic<uint32_t> next_ticket{0};
+    alignas(64) std::atomic<uint32_t> now_serving{0};
+    alignas(64) int spin_count;
+#if USE_LOCK_STAT
+    lock_stat_site stat;
+#endif
+};
+
+// queue node of MCS/CLH locks (one per thread per held lock)
+struct alignas(64) queue_lock_node {
+    std::atomic<queue_lock_node*> next{nullptr};
+    std::atomic<bool> locked{false};
+    queue_lock_node *next_free = nullptr;
+};
+
+// per-thread pool of queue nodes (a thread may hold several queue locks at once)
+class queue_lock_node_pool {
+public:
+    ~queue_lock_node_pool() {
+        // nodes in the pool are no longer referenced by any lock
+        while(free_list != nullptr) {
+            queue_lock_node *next = free_list->next_free;
+            delete free_list;
+            free_list = next;
+        }
+    }
+    
+    inline queue_lock_node *acquire() {
+        queue_lock_node *node = free_list;
+        if(node == nullptr)
+            return new queue_lock_node();
+        free_list = node->next_free;
+        return node;
+    }
+    
+    inline void release(queue_lock_node *node) {
+        node->next_free = free_list;
+        free_list = node;
+    }
+    
+    static queue_lock_node_pool &get() {
+        thread_local queue_lock_node_pool pool;
+        return pool;
+    }
+    
+private:
+    queue_lock_node *free_list = nullptr;
+};
+
+// MCS lock (FIFO, every waiter spins on its own node)
+class mcs_mutex {
+public:
+    mcs_mutex(int new_spin_count = DEFAULT_SPIN_COUNT) : spin_count(new_spin_count) {}
+    
+    // names the lock in lockstat reports (no-op unless USE_LOCK_STAT)
+    inline void set_lock_name(const char *name) {
+#if USE_LOCK_STAT
+        stat.name = name;
+#endif
+        (void)name;
+    }
+    
+    inline void lock() {
+        queue_lock_node *node = queue_lock_node_pool::get().acquire();
+        node->next.store(nullptr, std::memory_order_relaxed);
+        node->locked.store(true, std::memory_order_relaxed);
+        
+        queue_lock_node *pred = tail.exchange(node, std::memory_order_acq_rel);
+        if(pred != nullptr) {
+#if USE_LOCK_STAT
+            uint64_t wait_begin = lock_stat_now();
+#endif
+            pred->next.store(node, std::memory_order_release);
+            spin_wait waiter(spin_count);
+            while(node->locked.load(std::memory_order_acquire))
+                waiter.wait();
+#if USE_LOCK_STAT
+            stat.on_contended_acquire(wait_begin, waiter.get_total_spins());
+        }
+        else {
+            stat.on_acquire();
+#endif
+        }
+        owner_node = node;
+    }
+    
+    inline bool try_lock() {
+        queue_lock_node *node = queue_lock_node_pool::get().acquire();
+        node->next.store(nullptr, std::memory_order_relaxed);
+        queue_lock_node *expected = nullptr;
+        if(!tail.compare_exchange_strong(expected, node, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            queue_lock_node_pool::get().release(node);
+            return false;
+        }
+        owner_node = node;
+#if USE_LOCK_STAT
+        stat.on_acquire();
+#endif
+        return true;
+    }
+    
+    inline void unlock() {
+#if USE_LOCK_STAT
+        stat.on_release(this);
+#endif
+        queue_lock_node *node = owner_node;
+        queue_lock_node *succ = node->next.load(std::memory_order_acquire);
+        if(succ == nullptr) {
+            queue_lock_node *expected = node;
+            if(tail.compare_exchange_strong(expected, nullptr, std::memory_order_release, std::memory_order_relaxed)) {
+                queue_lock_node_pool::get().release(node);
+                return;
+            }
+            // a successor swapped the tail but hasn't linked itself yet
+            spin_wait waiter(spin_count);
+            while((succ = node->next.load(std::memory_order_acquire)) == nullptr)
+                waiter.wait();
+        }
+        succ->locked.store(false, std::memory_order_release);
+        queue_lock_node_pool::get().release(node);
+    }
+    
+private:
+    alignas(64) std::atomic<queue_lock_node*> tail{nullptr};
+    // written by the owner only
+    alignas(64) queue_lock_node *owner_node = nullptr;
+    int spin_count;
+#if USE_LOCK_STAT
+    lock_stat_site stat;
+#endif
+};
+
+// CLH lock (FIFO, every waiter spins on its predecessor's node)
+//
+// No try_lock() : a released tail node goes back to the node pool and can be
+// queued again, so a CAS on the tail can't tell it from a held one, and a
+// thread that got in can't leave the queue without waiting.
+class clh_mutex {
+public:
+    clh_mutex(int new_spin_count = DEFAULT_SPIN_COUNT) : spin_count(new_spin_count) {
+        tail.store(new queue_lock_node(), std::memory_order_relaxed);
+    }
+    
+    ~clh_mutex() {
+        delete tail.load(std::memory_order_relaxed);
+    }
+    
+    // names the lock in lockstat reports (no-op unless USE_LOCK_STAT)
+    inline void set_lock_name(const char *name) {
+#if USE_LOCK_STAT
+        stat.name = name;
+#endif
+        (void)name;
+    }
+    
+    inline void lock() {
+        queue_lock_node *node = queue_lock_node_pool::get().acquire();
+        node->locked.store(true, std::memory_order_relaxed);
+        
+        queue_lock_node *pred = tail.exchange(node, std::memory_order_acq_rel);
+#if USE_LOCK_STAT
+        if(pred->locked.load(std::memory_order_acquire)) {
+            uint64_t wait_begin = lock_stat_now();
+            spin_wait waiter(spin_count);
+            while(pred->locked.load(std::memory_order_acquire))
+                waiter.wait();
+            stat.on_contended_acquire(wait_begin, waiter.get_total_spins());
+        }
+        else {
+            stat.on_acquire();
+        }
 #else
-    alignas(64) std::atomic_flag flag = ATOMIC_FLAG_INIT;
+        spin_wait waiter(spin_count);
+        while(pred->locked.load(std::memory_order_acquire))
+            waiter.wait();
 #endif
-    alignas(64) int spin_count;
+        owner_node = node;
+        owner_pred = pred;
+    }
+    
+    inline void unlock() {
+#if USE_LOCK_STAT
+        stat.on_release(this);
+#endif
+        queue_lock_node *pred = owner_pred;
+        owner_node->locked.store(false, std::memory_order_release);
+        // our node now belongs to the successor, the predecessor's node becomes ours
+        queue_lock_node_pool::get().release(pred);
+    }
+    
+private:
+    alignas(64) std::atomic<queue_lock_node*> tail;
+    // written by the owner only
+    alignas(64) queue_lock_node *owner_node = nullptr;
+    queue_lock_node *owner_pred = nullptr;
+    int spin_count;
+#if USE_LOCK_STAT
+    lock_stat_site stat;
+#endif
+};
+
+// reader-writer spinlock with distributed reader counters
+//
+// Readers only touch the counter slot of their thread, so read-mostly
+// locks don't bounce a shared cache line between cores. A writer raises
+// the writer flag first (new readers back off) and then waits for every
+// slot to drain, so writers are preferred over incoming readers.
+class rw_spinlock_mutex {
+public:
+    rw_spinlock_mutex(int new_spin_count = DEFAULT_SPIN_COUNT) : spin_count(new_spin_count) {}
+    
+    // names the lock in lockstat reports (no-op unless USE_LOCK_STAT)
+    inline void set_lock_name(const char *name) {
+#if USE_LOCK_STAT
+        stat.name = name;
+#endif
+        (void)name;
+    }
+    
+    inline void lock_shared() {
+        reader_slot_t &slot = get_reader_slot();
+#if USE_LOCK_STAT
+        uint64_t wait_begin = 0;
+        uint64_t spins = 0;
+#endif
+        for(;;) {
+            slot.readers.fetch_add(1, std::memory_order_seq_cst);
+            if(!writer.load(std::memory_order_seq_cst)) {
+#if USE_LOCK_STAT
+                // readers share the lock, so they are recorded on acquire without a hold time
+                uint64_t wait_ns = wait_begin != 0 ? lock_stat_now() - wait_begin : 0;
+                global_lock_stat.record(this, stat.name, wait_ns, 0, wait_begin != 0, spins);
+#endif
+                return;
+            }
+            
+            // a writer is active or waiting, step aside until it is done
+            slot.readers.fetch_sub(1, std::memory_order_release);
+#if USE_LOCK_STAT
+            if(wait_begin == 0)
+                wait_begin = lock_stat_now();
+#endif
+            spin_wait waiter(spin_count);
+            while(writer.load(std::memory_order_relaxed))
+                waiter.wait();
+#if USE_LOCK_STAT
+            spins += waiter.get_total_spins();
+#endif
+        }
+    }
+    
+    inline void unlock_shared() {
+        get_reader_slot().readers.fetch_sub(1, std::memory_order_release);
+    }
+    
+    inline void lock() {
+        spin_wait waiter(spin_count);
+        bool expected = false;
+#if USE_LOCK_STAT
+        uint64_t wait_begin = lock_stat_now();
+        bool contended = false;
+#endif
+        while(writer.load(std::memory_order_relaxed) || !writer.compare_exchange_weak(expected, true, std::memory_order_seq_cst)) {
+            expected = false;
+#if USE_LOCK_STAT
+            contended = true;
+#endif
+            waiter.wait();
+        }
+        for(uint32_t i = 0; i < RW_LOCK_READER_SLOTS; i++) {
+            while(reader_slots[i].readers.load(std::memory_order_seq_cst) != 0) {
+#if USE_LOCK_STAT
+                contended = true;
+#endif
+                waiter.wait();
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+#if USE_LOCK_STAT
+        if(contended)
+            stat.on_contended_acquire(wait_begin, waiter.get_total_spins());
+        else
+            stat.on_acquire();
+#endif
+    }
+    
+    inline void unlock() {
+#if USE_LOCK_STAT
+        stat.on_release(this);
+#endif
+        writer.store(false, std::memory_order_release);
+    }
+    
+private:
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) reader_slot_t {
+        std::atomic<int32_t> readers{0};
+    };
+    
+    inline reader_slot_t &get_reader_slot() {
+        return reader_slots[threadlocal_get_thread_id() & (RW_LOCK_READER_SLOTS - 1)];
+    }
+    
+private:
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<bool> writer{false};
+    int spin_count;
+    reader_slot_t reader_slots[RW_LOCK_READER_SLOTS];
+#if USE_LOCK_STAT
+    lock_stat_site stat;
+#endif
+    
+    static_assert((RW_LOCK_READER_SLOTS & (RW_LOCK_READER_SLOTS - 1)) == 0, "The number of reader slots must be power of 2!");
 };
 
 // spinlock critical section
@@ -97,6 +598,14 @@ class spinlock_critical_section {
 public:
     spinlock_critical_section(int new_spin_count = DEFAULT_SPIN_COUNT) : spin_count(new_spin_count), enter_count(0) {}
     
+    // names the lock in lockstat reports (no-op unless USE_LOCK_STAT)
+    inline void set_lock_name(const char *name) {
+#if USE_LOCK_STAT
+        stat.name = name;
+#endif
+        (void)name;
+    }
+    
     void lock() {
         auto this_thread_id = std::this_thread::get_id();
         if(thread_id == this_thread_id) {
@@ -104,11 +613,29 @@ public:
             return;
         }
 
+#if USE_LOCK_STAT
+        if(flag.test_and_set(std::memory_order_seq_cst)) {
+            uint64_t wait_begin = lock_stat_now();
+            uint64_t spins = 0;
+            do {
+                for(int i = 0; i < spin_count; i++) {
+                    std::this_thread::yield();
+                }
+                spins += spin_count;
+            }
+            while(flag.test_and_set(std::memory_order_seq_cst));
+            stat.on_contended_acquire(wait_begin, spins);
+        }
+        else {
+            stat.on_acquire();
+        }
+#else
         while(flag.test_and_set(std::memory_order_seq_cst)) {
             for(int i = 0; i < spin_count; i++) {
                 std::this_thread::yield();
             }
         }
+#endif
         thread_id = this_thread_id;
         enter_count = 1;
     }
@@ -116,6 +643,9 @@ public:
     void unlock() {
         enter_count--;
         if(enter_count == 0) {
+#if USE_LOCK_STAT
+            stat.on_release(this);
+#endif
             thread_id = std::thread::id();
             flag.clear(std::memory_order_seq_cst);
         }
@@ -126,6 +656,9 @@ private:
     alignas(64) int spin_count;
     alignas(64) std::thread::id thread_id;
     int enter_count;
+#if USE_LOCK_STAT
+    lock_stat_site stat;
+#endif
 };
 
 #endif /* Mutex_h */
@@ -0,0 +1,131 @@
+//
+//  SeqLock.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef SeqLock_h
+#define SeqLock_h
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "Mutex.h"
+
+// Sequence lock
+//
+// Writers make the sequence odd while they update the protected data and
+// even again when they are done. Readers never write shared memory: they
+// read the data between read_begin() and read_retry() and start over if a
+// writer got in between. lock()/unlock() fit scoped_lock for the writer.
+class seqlock {
+public:
+    seqlock(int new_spin_count = DEFAULT_SPIN_COUNT) : spin_count(new_spin_count) {}
+    
+    inline void lock() {
+        spin_wait waiter(spin_count);
+        uint32_t seq = sequence.load(std::memory_order_relaxed);
+        while((seq & 1) || !sequence.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            waiter.wait();
+            seq = sequence.load(std::memory_order_relaxed);
+        }
+        // keeps the data stores after the odd sequence
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+    
+    inline void unlock() {
+        sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    
+    // returns the sequence to pass to read_retry()
+    inline uint32_t read_begin() {
+        uint32_t seq = sequence.load(std::memory_order_acquire);
+        if(seq & 1) {
+            spin_wait waiter(spin_count);
+            do {
+                waiter.wait();
+                seq = sequence.load(std::memory_order_acquire);
+            }
+            while(seq & 1);
+        }
+        return seq;
+    }
+    
+    // true if the data read since read_begin() may be torn
+    inline bool read_retry(uint32_t seq) {
+        // keeps the data loads before the sequence check
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence.load(std::memory_order_relaxed) != seq;
+    }
+    
+private:
+    alignas(64) std::atomic<uint32_t> sequence{0};
+    int spin_count;
+};
+
+// small POD value guarded by a seqlock (snapshots of configs, statistics, ...)
+template<typename T>
+class seqlock_value {
+public:
+    seqlock_value() {
+        store(T());
+    }
+    
+    seqlock_value(const T &value) {
+        store(value);
+    }
+    
+    T load() {
+        T value;
+        uint32_t seq;
+        do {
+            seq = lock.read_begin();
+            copy_from_words(value);
+        }
+        while(lock.read_retry(seq));
+        return value;
+    }
+    
+    void store(const T &value) {
+        scoped_lock<seqlock> guard{ &lock };
+        copy_to_words(value);
+    }
+    
+    // read-modify-write under the writer lock
+    template<typename func_t>
+    void update(func_t func) {
+        scoped_lock<seqlock> guard{ &lock };
+        T value;
+        copy_from_words(value);
+        func(value);
+        copy_to_words(value);
+    }
+    
+private:
+    // the value is kept in relaxed atomic words, so torn reads are detected instead of being data races
+    static constexpr size_t num_words = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    
+    inline void copy_from_words(T &value) {
+        uint64_t buffer[num_words];
+        for(size_t i = 0; i < num_words; i++)
+            buffer[i] = words[i].load(std::memory_order_relaxed);
+        std::memcpy(&value, buffer, sizeof(T));
+    }
+    
+    inline void copy_to_words(const T &value) {
+        uint64_t buffer[num_words] = {};
+        std::memcpy(buffer, &value, sizeof(T));
+        for(size_t i = 0; i < num_words; i++)
+            words[i].store(buffer[i], std::memory_order_relaxed);
+    }
+    
+private:
+    seqlock lock;
+    std::atomic<uint64_t> words[num_words];
+    
+    static_assert(std::is_trivially_copyable<T>::value, "seqlock_value only supports trivially copyable types!");
+};
+
+#endif /* SeqLock_h */
@@ -0,0 +1,174 @@
+//
+//  ShardedCounter.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef ShardedCounter_h
+#define ShardedCounter_h
+
+#include <atomic>
+#include <cstdint>
+#include "../Thread/ThreadLocal.h"
+#include "../../Platform/PlatformDefine.h"
+
+// number of counter shards (must be power of 2)
+#define SHARDED_COUNTER_SHARDS 64
+
+// number of log2 buckets of sharded_histogram
+#define SHARDED_HISTOGRAM_BUCKETS 64
+
+// index of the shard of the calling thread
+inline uint32_t sharded_counter_get_shard() {
+    return threadlocal_get_thread_id() & (SHARDED_COUNTER_SHARDS - 1);
+}
+
+// Sharded counter
+//
+// Every thread adds into the cache-line-padded shard of its thread id, so
+// increments stay in the core's own cache; read() sums the shards on demand
+// (exact once the writers are quiet, a close approximation otherwise).
+class sharded_counter {
+public:
+    inline void add(int64_t value = 1) {
+        shards[sharded_counter_get_shard()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+    
+    int64_t read() const {
+        int64_t total = 0;
+        for(uint32_t i = 0; i < SHARDED_COUNTER_SHARDS; i++)
+            total += shards[i].value.load(std::memory_order_relaxed);
+        return total;
+    }
+    
+    // sums and clears the shards (concurrent adds land in either this or the next read)
+    int64_t read_and_reset() {
+        int64_t total = 0;
+        for(uint32_t i = 0; i < SHARDED_COUNTER_SHARDS; i++)
+            total += shards[i].value.exchange(0, std::memory_order_relaxed);
+        return total;
+    }
+    
+private:
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) shard_t {
+        std::atomic<int64_t> value{0};
+    };
+    
+    shard_t shards[SHARDED_COUNTER_SHARDS];
+    
+    static_assert((SHARDED_COUNTER_SHARDS & (SHARDED_COUNTER_SHARDS - 1)) == 0, "The shard count must be power of 2!");
+};
+
+// Sharded gauge (a level that goes up and down, e.g. in-flight requests)
+//
+// Shards hold signed deltas, so a thread may decrement what another thread
+// incremented. Only the sum is meaningful, a peak has to be sampled from
+// read() by the caller.
+class sharded_gauge {
+public:
+    inline void increment() { add(1); }
+    inline void decrement() { add(-1); }
+    
+    inline void add(int64_t delta) {
+        shards[sharded_counter_get_shard()].value.fetch_add(delta, std::memory_order_relaxed);
+    }
+    
+    int64_t read() const {
+        int64_t total = 0;
+        for(uint32_t i = 0; i < SHARDED_COUNTER_SHARDS; i++)
+            total += shards[i].value.load(std::memory_order_relaxed);
+        return total;
+    }
+    
+private:
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) shard_t {
+        std::atomic<int64_t> value{0};
+    };
+    
+    shard_t shards[SHARDED_COUNTER_SHARDS];
+};
+
+// merged view of a sharded_histogram
+struct histogram_snapshot {
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t buckets[SHARDED_HISTOGRAM_BUCKETS] = {};
+    
+    double mean() const {
+        return count > 0 ? (double)sum / count : 0;
+    }
+    
+    // upper bound of the bucket containing the percentile (0 ~ 1)
+    uint64_t percentile(double p) const {
+        uint64_t rank = (uint64_t)(p * count);
+        uint64_t seen = 0;
+        for(uint32_t i = 0; i < SHARDED_HISTOGRAM_BUCKETS; i++) {
+            seen += buckets[i];
+            if(seen > rank)
+                return i == 0 ? 0 : (i == SHARDED_HISTOGRAM_BUCKETS - 1 ? UINT64_MAX : (uint64_t(1) << i) - 1);
+        }
+        return UINT64_MAX;
+    }
+};
+
+// Sharded histogram (log2 buckets : bucket i holds values in [2^(i-1), 2^i), the last one the rest)
+class sharded_histogram {
+public:
+    sharded_histogram() {
+        for(uint32_t i = 0; i < SHARDED_COUNTER_SHARDS; i++)
+            shards[i] = new shard_t();
+    }
+    
+    ~sharded_histogram() {
+        for(uint32_t i = 0; i < SHARDED_COUNTER_SHARDS; i++)
+            delete shards[i];
+    }
+    
+    sharded_histogram(const sharded_histogram&) = delete;
+    sharded_histogram& operator=(const sharded_histogram&) = delete;
+    
+    inline void record(uint64_t value) {
+        shard_t &shard = *shards[sharded_counter_get_shard()];
+        shard.buckets[get_bucket(value)].fetch_add(1, std::memory_order_relaxed);
+        shard.count.fetch_add(1, std::memory_order_relaxed);
+        shard.sum.fetch_add(value, std::memory_order_relaxed);
+    }
+    
+    histogram_snapshot snapshot() const {
+        histogram_snapshot result;
+        for(uint32_t i = 0; i < SHARDED_COUNTER_SHARDS; i++) {
+            const shard_t &shard = *shards[i];
+            result.count += shard.count.load(std::memory_order_relaxed);
+            result.sum += shard.sum.load(std::memory_order_relaxed);
+            for(uint32_t k = 0; k < SHARDED_HISTOGRAM_BUCKETS; k++)
+                result.buckets[k] += shard.buckets[k].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+    
+    static inline uint32_t get_bucket(uint64_t value) {
+        uint32_t bucket = 0;
+#if __GNUC__
+        bucket = value == 0 ? 0 : 64 - __builtin_clzll(value);
+#else
+        while(value != 0) {
+            value >>= 1;
+            bucket++;
+        }
+#endif
+        return bucket < SHARDED_HISTOGRAM_BUCKETS ? bucket : SHARDED_HISTOGRAM_BUCKETS - 1;
+    }
+    
+private:
+    // shards are allocated separately (about half a kilobyte each)
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) shard_t {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sum{0};
+        std::atomic<uint64_t> buckets[SHARDED_HISTOGRAM_BUCKETS] = {};
+    };
+    
+    shard_t *shards[SHARDED_COUNTER_SHARDS];
+};
+
+#endif /* ShardedCounter_h */
@@ -0,0 +1,249 @@
+//
+//  SharedRingQueue.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef SharedRingQueue_h
+#define SharedRingQueue_h
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include "../Memory/SharedRegion.h"
+#include "../../Platform/PlatformDefine.h"
+
+// value of a slot whose producer died before publishing (never returned by try_dequeue)
+#define SHARED_RING_TOMBSTONE UINT64_MAX
+
+// slot sequence layout : state (2 bits) | owner participant (6 bits) | position (56 bits)
+#define SHARED_RING_STATE_SHIFT 62
+#define SHARED_RING_OWNER_SHIFT 56
+#define SHARED_RING_POSITION_MASK ((uint64_t(1) << SHARED_RING_OWNER_SHIFT) - 1)
+
+// Inter-process bounded MPMC ring queue (Vyukov, with claimed slots)
+//
+// Lives inside a shared_region and carries 64-bit values, usually region
+// offsets of message blocks, so nothing is copied through the kernel.
+// Unlike the original algorithm, a slot is first claimed by a CAS on its
+// sequence that records the owner's participant index, and the shared
+// cursor is advanced afterwards (by anyone who sees the claim). A process
+// that dies between claiming and completing leaves the slot stuck with
+// its index in it; recover() finds such slots of dead participants,
+// turns an unpublished value into a tombstone, and hands an unconsumed
+// value to a callback so its block can be freed.
+class shared_ring_queue {
+public:
+    shared_ring_queue() {}
+
+    // builds a new ring in the region (capacity must be power of 2)
+    bool create(shared_region *new_region, uint64_t capacity) {
+        assert((capacity & (capacity - 1)) == 0 && capacity < SHARED_RING_POSITION_MASK);
+        uint64_t offset = new_region->allocate_pages(sizeof(ring_t) + capacity * sizeof(slot_t));
+        if(offset == 0)
+            return false;
+        region = new_region;
+        ring = region->get_pointer<ring_t>(offset);
+        ring->capacity = capacity;
+        for(uint64_t i = 0; i < capacity; i++)
+            ring->slots[i].sequence.store(i, std::memory_order_relaxed);
+        ring->enqueue_pos.store(0, std::memory_order_relaxed);
+        ring->dequeue_pos.store(0, std::memory_order_release);
+        return true;
+    }
+
+    // opens a ring built by another process
+    void open(shared_region *new_region, uint64_t offset) {
+        region = new_region;
+        ring = region->get_pointer<ring_t>(offset);
+    }
+
+    inline uint64_t get_offset() const { return region->get_offset(ring); }
+    inline uint64_t get_capacity() const { return ring->capacity; }
+
+public:
+    // returns false when the ring is full
+    bool try_enqueue(uint64_t value) {
+        assert(value != SHARED_RING_TOMBSTONE);
+        uint64_t pos = ring->enqueue_pos.load(std::memory_order_relaxed);
+        for(;;) {
+            slot_t &slot = get_slot(pos);
+            uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+            uint64_t seq_pos = seq & SHARED_RING_POSITION_MASK;
+            uint64_t state = seq >> SHARED_RING_STATE_SHIFT;
+            if(seq == pos) {
+                if(slot.sequence.compare_exchange_strong(seq, make_claim(STATE_ENQUEUE, pos), std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                    advance(ring->enqueue_pos, pos);
+                    slot.value.store(value, std::memory_order_relaxed);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if((state == STATE_ENQUEUE && seq_pos == pos) || seq == pos + 1) {
+                // taken by a producer that hasn't moved the cursor yet
+                advance(ring->enqueue_pos, pos);
+            }
+            else if((int64_t)(seq_pos - pos) < 0) {
+                // the slot still holds the previous lap (possibly being consumed)
+                uint64_t new_pos = ring->enqueue_pos.load(std::memory_order_relaxed);
+                if(new_pos == pos)
+                    return false;
+                pos = new_pos;
+                continue;
+            }
+            pos = ring->enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // returns false when the ring is empty, or the next value is still being written
+    bool try_dequeue(uint64_t &out_value) {
+        const uint64_t capacity = ring->capacity;
+        uint64_t pos = ring->dequeue_pos.load(std::memory_order_relaxed);
+        for(;;) {
+            slot_t &slot = get_slot(pos);
+            uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+            uint64_t seq_pos = seq & SHARED_RING_POSITION_MASK;
+            uint64_t state = seq >> SHARED_RING_STATE_SHIFT;
+            if(seq == pos + 1) {
+                if(slot.sequence.compare_exchange_strong(seq, make_claim(STATE_DEQUEUE, pos), std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                    advance(ring->dequeue_pos, pos);
+                    uint64_t value = slot.value.load(std::memory_order_relaxed);
+                    slot.sequence.store(pos + capacity, std::memory_order_release);
+                    if(value != SHARED_RING_TOMBSTONE) {
+                        out_value = value;
+                        return true;
+                    }
+                }
+            }
+            else if((state == STATE_DEQUEUE && seq_pos == pos) || seq == pos + capacity) {
+                // taken by a consumer that hasn't moved the cursor yet
+                advance(ring->dequeue_pos, pos);
+            }
+            else if(seq == pos || (state == STATE_ENQUEUE && seq_pos == pos)) {
+                uint64_t new_pos = ring->dequeue_pos.load(std::memory_order_relaxed);
+                if(new_pos == pos)
+                    return false;
+                pos = new_pos;
+                continue;
+            }
+            pos = ring->dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // repairs the slots claimed by dead participants and returns their count;
+    // on_lost(value) gets the values a dead consumer had taken but not
+    // returned yet. The caller must be attached too. O(capacity), meant for
+    // a watchdog or for a waiter that stayed blocked for a while.
+    template<typename func_t>
+    uint32_t recover(func_t on_lost) {
+        const uint64_t capacity = ring->capacity;
+        uint32_t count = 0;
+        for(uint64_t i = 0; i < capacity; i++) {
+            slot_t &slot = ring->slots[i];
+            uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+            uint64_t state = seq >> SHARED_RING_STATE_SHIFT;
+            if(state == STATE_NONE)
+                continue;
+            uint32_t owner = (uint32_t)(seq >> SHARED_RING_OWNER_SHIFT) & (SHARED_REGION_MAX_PARTICIPANTS - 1);
+            if(region->is_participant_alive(owner))
+                continue;
+
+            // take the claim over first, so only one recoverer touches the slot
+            uint64_t pos = seq & SHARED_RING_POSITION_MASK;
+            if(!slot.sequence.compare_exchange_strong(seq, make_claim(state, pos), std::memory_order_acq_rel, std::memory_order_relaxed))
+                continue;
+            if(state == STATE_ENQUEUE) {
+                advance(ring->enqueue_pos, pos);
+                slot.value.store(SHARED_RING_TOMBSTONE, std::memory_order_relaxed);
+                slot.sequence.store(pos + 1, std::memory_order_release);
+            }
+            else {
+                advance(ring->dequeue_pos, pos);
+                uint64_t value = slot.value.load(std::memory_order_relaxed);
+                slot.sequence.store(pos + capacity, std::memory_order_release);
+                if(value != SHARED_RING_TOMBSTONE)
+                    on_lost(value);
+            }
+            count++;
+        }
+        return count;
+    }
+
+    uint32_t recover() {
+        return recover([](uint64_t) {});
+    }
+
+    // approximate number of queued values
+    uint64_t size() const {
+        uint64_t enqueue_pos = ring->enqueue_pos.load(std::memory_order_relaxed);
+        uint64_t dequeue_pos = ring->dequeue_pos.load(std::memory_order_relaxed);
+        return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+    }
+
+    // debug-only, claims the next producer slot and never publishes it (simulates a crash)
+    bool debug_claim_enqueue() {
+        uint64_t pos = ring->enqueue_pos.load(std::memory_order_relaxed);
+        uint64_t seq = pos;
+        if(!get_slot(pos).sequence.compare_exchange_strong(seq, make_claim(STATE_ENQUEUE, pos), std::memory_order_acq_rel))
+            return false;
+        advance(ring->enqueue_pos, pos);
+        return true;
+    }
+
+    // debug-only, claims the next consumer slot and never releases it (simulates a crash)
+    bool debug_claim_dequeue() {
+        uint64_t pos = ring->dequeue_pos.load(std::memory_order_relaxed);
+        uint64_t seq = pos + 1;
+        if(!get_slot(pos).sequence.compare_exchange_strong(seq, make_claim(STATE_DEQUEUE, pos), std::memory_order_acq_rel))
+            return false;
+        advance(ring->dequeue_pos, pos);
+        return true;
+    }
+
+private:
+    enum : uint64_t {
+        STATE_NONE = 0,
+        STATE_ENQUEUE = 1,
+        STATE_DEQUEUE = 2,
+    };
+
+    struct slot_t {
+        std::atomic<uint64_t> sequence;
+        std::atomic<uint64_t> value;
+    };
+
+    // shared layout, placed at a page boundary of the region
+    struct ring_t {
+        uint64_t capacity;
+        alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64_t> enqueue_pos;
+        alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64_t> dequeue_pos;
+        alignas(PLATFORM_CACHE_LINE_SIZE) slot_t slots[1];
+    };
+
+private:
+    inline slot_t &get_slot(uint64_t pos) const {
+        return ring->slots[pos & (ring->capacity - 1)];
+    }
+
+    inline uint64_t make_claim(uint64_t state, uint64_t pos) const {
+        int owner = region->get_participant_index();
+        assert(owner >= 0);
+        return state << SHARED_RING_STATE_SHIFT | (uint64_t)owner << SHARED_RING_OWNER_SHIFT | pos;
+    }
+
+    // moves the cursor past pos unless somebody already did
+    static inline void advance(std::atomic<uint64_t> &cursor, uint64_t pos) {
+        cursor.compare_exchange_strong(pos, pos + 1, std::memory_order_relaxed);
+    }
+
+private:
+    // process-local handle
+    shared_region *region = nullptr;
+    ring_t *ring = nullptr;
+
+    static_assert(SHARED_REGION_MAX_PARTICIPANTS <= (1 << (SHARED_RING_STATE_SHIFT - SHARED_RING_OWNER_SHIFT)), "The owner bits can't hold every participant!");
+};
+
+#endif /* SharedRingQueue_h */
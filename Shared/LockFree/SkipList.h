@@ -0,0 +1,322 @@
+//
+//  SkipList.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef SkipList_h
+#define SkipList_h
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include "../Memory/EpochReclaimer.h"
+#include "../../Option/Option.h"
+
+#if USE_MEMORY_POOL
+#include "../Memory/MemoryPool.h"
+#endif
+
+// maximum height of node towers
+#define SKIP_LIST_MAX_LEVEL 20
+
+// Lock-free skip list (Fraser / Herlihy-Shavit)
+//
+// A node is logically deleted once the mark bit of its level-0 link is set,
+// then unlinked from every level by the next search passing over it. Nodes
+// are freed through the global epoch reclaimer, so every operation runs in
+// an epoch_guard. Keys are unique and ordered by operator<.
+template<typename K, typename V>
+class lf_skip_list {
+public:
+    lf_skip_list() {
+        head = create_node(K(), V(), SKIP_LIST_MAX_LEVEL);
+    }
+
+    // must not be called while other threads still use the list
+    ~lf_skip_list() {
+        node_t *node = head;
+        while(node != nullptr) {
+            node_t *next = get_ptr(node->next(0).load(std::memory_order_relaxed));
+            destroy_node(node);
+            node = next;
+        }
+    }
+
+    lf_skip_list(const lf_skip_list&) = delete;
+    lf_skip_list& operator=(const lf_skip_list&) = delete;
+
+public:
+    // inserts the value if the key doesn't exist
+    bool insert(const K &key, const V &value) {
+        epoch_guard guard;
+        node_t *preds[SKIP_LIST_MAX_LEVEL];
+        node_t *succs[SKIP_LIST_MAX_LEVEL];
+        uint32_t top_level = random_level();
+        node_t *node = nullptr;
+
+        for(;;) {
+            if(find_position(key, preds, succs)) {
+                if(node != nullptr)
+                    destroy_node(node);
+                return false;
+            }
+            if(node == nullptr)
+                node = create_node(key, value, top_level);
+            for(uint32_t level = 0; level < top_level; level++)
+                node->next(level).store((uintptr_t)succs[level], std::memory_order_relaxed);
+
+            // linking level 0 makes the node visible
+            uintptr_t expected = (uintptr_t)succs[0];
+            if(preds[0]->next(0).compare_exchange_strong(expected, (uintptr_t)node))
+                break;
+        }
+
+        for(uint32_t level = 1; level < top_level; level++) {
+            for(;;) {
+                // the node is being erased, stop linking upper levels
+                uintptr_t next = node->next(level).load();
+                if(is_marked(next))
+                    break;
+                if(get_ptr(next) != succs[level] && !node->next(level).compare_exchange_strong(next, (uintptr_t)succs[level]))
+                    break;
+
+                uintptr_t expected = (uintptr_t)succs[level];
+                if(preds[level]->next(level).compare_exchange_strong(expected, (uintptr_t)node))
+                    break;
+                find_position(key, preds, succs);
+            }
+        }
+
+        // an eraser that raced with the linking above may need us to unlink it
+        if(is_marked(node->next(0).load()))
+            find_position(key, preds, succs);
+        release_node(node);
+        return true;
+    }
+
+    bool find(const K &key, V &out_value) {
+        epoch_guard guard;
+        node_t *pred = head;
+        node_t *curr = nullptr;
+        for(int level = SKIP_LIST_MAX_LEVEL - 1; level >= 0; level--) {
+            curr = get_ptr(pred->next(level).load(std::memory_order_acquire));
+            for(;;) {
+                if(curr == nullptr)
+                    break;
+                uintptr_t succ = curr->next(level).load(std::memory_order_acquire);
+                // skip logically deleted nodes without unlinking them
+                if(is_marked(succ)) {
+                    curr = get_ptr(succ);
+                    continue;
+                }
+                if(!(curr->key < key))
+                    break;
+                pred = curr;
+                curr = get_ptr(succ);
+            }
+        }
+        if(curr == nullptr || key < curr->key || is_marked(curr->next(0).load(std::memory_order_acquire)))
+            return false;
+        out_value = curr->value;
+        return true;
+    }
+
+    bool contains(const K &key) {
+        V value;
+        return find(key, value);
+    }
+
+    bool erase(const K &key) {
+        V value;
+        return erase(key, value);
+    }
+
+    bool erase(const K &key, V &out_value) {
+        epoch_guard guard;
+        node_t *preds[SKIP_LIST_MAX_LEVEL];
+        node_t *succs[SKIP_LIST_MAX_LEVEL];
+        if(!find_position(key, preds, succs))
+            return false;
+        node_t *victim = succs[0];
+        if(!mark_node(victim))
+            return false;
+        out_value = victim->value;
+        find_position(key, preds, succs);
+        release_node(victim);
+        return true;
+    }
+
+    // removes the smallest entry (concurrent priority queue mode)
+    bool pop_min(K &out_key, V &out_value) {
+        epoch_guard guard;
+        node_t *curr = get_ptr(head->next(0).load(std::memory_order_acquire));
+        while(curr != nullptr) {
+            uintptr_t succ = curr->next(0).load(std::memory_order_acquire);
+            if(!is_marked(succ) && mark_node(curr)) {
+                out_key = curr->key;
+                out_value = curr->value;
+                node_t *preds[SKIP_LIST_MAX_LEVEL];
+                node_t *succs[SKIP_LIST_MAX_LEVEL];
+                find_position(curr->key, preds, succs);
+                release_node(curr);
+                return true;
+            }
+            curr = get_ptr(curr->next(0).load(std::memory_order_acquire));
+        }
+        return false;
+    }
+
+    // calls func(key, value) for the live entries in [from, to) in order (weakly consistent)
+    template<typename func_t>
+    void for_each_range(const K &from, const K &to, func_t func) {
+        epoch_guard guard;
+        node_t *preds[SKIP_LIST_MAX_LEVEL];
+        node_t *succs[SKIP_LIST_MAX_LEVEL];
+        find_position(from, preds, succs);
+        for(node_t *curr = succs[0]; curr != nullptr; ) {
+            if(!(curr->key < to))
+                break;
+            uintptr_t succ = curr->next(0).load(std::memory_order_acquire);
+            if(!is_marked(succ))
+                func(curr->key, curr->value);
+            curr = get_ptr(succ);
+        }
+    }
+
+    // calls func(key, value) for every live entry in order (weakly consistent)
+    template<typename func_t>
+    void for_each(func_t func) {
+        epoch_guard guard;
+        for(node_t *curr = get_ptr(head->next(0).load(std::memory_order_acquire)); curr != nullptr; ) {
+            uintptr_t succ = curr->next(0).load(std::memory_order_acquire);
+            if(!is_marked(succ))
+                func(curr->key, curr->value);
+            curr = get_ptr(succ);
+        }
+    }
+
+private:
+    // internal node structure (followed by the tower of next links)
+    struct alignas(std::atomic<uintptr_t>) node_t {
+        K key;
+        V value;
+        uint32_t top_level;
+        // held by the inserter until linked and by the eraser until unlinked
+        std::atomic<uint32_t> unlink_refs;
+
+        node_t(const K &in_key, const V &in_value, uint32_t in_top_level) : key(in_key), value(in_value), top_level(in_top_level), unlink_refs(2) {}
+
+        inline std::atomic<uintptr_t> &next(uint32_t level) {
+            return reinterpret_cast<std::atomic<uintptr_t>*>(this + 1)[level];
+        }
+    };
+
+    static constexpr uintptr_t MARK_BIT = 1;
+
+    static inline bool is_marked(uintptr_t link) { return (link & MARK_BIT) != 0; }
+    static inline node_t *get_ptr(uintptr_t link) { return (node_t*)(link & ~MARK_BIT); }
+
+    static size_t get_node_size(uint32_t top_level) {
+        return sizeof(node_t) + top_level * sizeof(std::atomic<uintptr_t>);
+    }
+
+    static node_t *create_node(const K &key, const V &value, uint32_t top_level) {
+        size_t size = get_node_size(top_level);
+        void *buffer;
+#if USE_MEMORY_POOL
+        // towers are taken from the pool size classes when they fit
+        if(size <= BLOCK_SIZE_LIST[NUM_BLOCK_SIZE - 1])
+            buffer = global_memory_pool.allocate(size);
+        else
+#endif
+            buffer = ::operator new(size);
+        node_t *node = new (buffer) node_t(key, value, top_level);
+        for(uint32_t level = 0; level < top_level; level++)
+            new (&node->next(level)) std::atomic<uintptr_t>(0);
+        return node;
+    }
+
+    static void destroy_node(node_t *node) {
+        size_t size = get_node_size(node->top_level);
+        node->~node_t();
+#if USE_MEMORY_POOL
+        if(size <= BLOCK_SIZE_LIST[NUM_BLOCK_SIZE - 1])
+            global_memory_pool.free(node);
+        else
+#endif
+            ::operator delete(node);
+        (void)size;
+    }
+
+    static uint32_t random_level() {
+        thread_local uint64_t state = (uint64_t)(uintptr_t)&state | 1;
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        uint32_t level = 1;
+        uint64_t bits = state;
+        while(level < SKIP_LIST_MAX_LEVEL && (bits & 1)) {
+            level++;
+            bits >>= 1;
+        }
+        return level;
+    }
+
+    // fills preds/succs for the key and unlinks marked nodes on the way
+    bool find_position(const K &key, node_t **preds, node_t **succs) {
+    retry:
+        node_t *pred = head;
+        node_t *curr = nullptr;
+        for(int level = SKIP_LIST_MAX_LEVEL - 1; level >= 0; level--) {
+            curr = get_ptr(pred->next(level).load());
+            for(;;) {
+                if(curr == nullptr)
+                    break;
+                uintptr_t succ = curr->next(level).load();
+                while(is_marked(succ)) {
+                    uintptr_t expected = (uintptr_t)curr;
+                    if(!pred->next(level).compare_exchange_strong(expected, (uintptr_t)get_ptr(succ)))
+                        goto retry;
+                    curr = get_ptr(succ);
+                    if(curr == nullptr)
+                        break;
+                    succ = curr->next(level).load();
+                }
+                if(curr == nullptr || !(curr->key < key))
+                    break;
+                pred = curr;
+                curr = get_ptr(succ);
+            }
+            preds[level] = pred;
+            succs[level] = curr;
+        }
+        return curr != nullptr && !(key < curr->key);
+    }
+
+    // marks every level top-down, returns true if this call did the logical deletion
+    static bool mark_node(node_t *node) {
+        for(uint32_t level = node->top_level - 1; level >= 1; level--) {
+            uintptr_t succ = node->next(level).load();
+            while(!is_marked(succ) && !node->next(level).compare_exchange_weak(succ, succ | MARK_BIT));
+        }
+        uintptr_t succ = node->next(0).load();
+        while(!is_marked(succ)) {
+            if(node->next(0).compare_exchange_strong(succ, succ | MARK_BIT))
+                return true;
+        }
+        return false;
+    }
+
+    // the last of the inserter and the eraser retires the node
+    static void release_node(node_t *node) {
+        if(node->unlink_refs.fetch_sub(1) == 1)
+            global_epoch_reclaimer.retire(node, [](void *ptr) { destroy_node((node_t*)ptr); });
+    }
+
+private:
+    node_t *head;
+};
+
+#endif /* SkipList_h */
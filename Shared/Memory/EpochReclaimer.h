@@ -0,0 +1,181 @@
+//
+//  EpochReclaimer.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef EpochReclaimer_h
+#define EpochReclaimer_h
+
+#include <atomic>
+#include <cassert>
+#include <vector>
+#include "../../Platform/PlatformDefine.h"
+
+// number of retired objects before trying to advance the epoch
+#define EPOCH_RECLAIM_THRESHOLD 64
+
+// Epoch-based memory reclamation
+//
+// Readers enter a critical region with epoch_guard. Unlinked objects are
+// retired with the epoch they were removed in, and freed once the global
+// epoch is two steps ahead (no reader can still hold them then).
+class epoch_reclaimer {
+public:
+    typedef void (*deleter_t)(void*);
+
+    epoch_reclaimer() : global_epoch(1), records(nullptr) {}
+
+    ~epoch_reclaimer() {
+        record_t *rec = records.load();
+        while(rec != nullptr) {
+            record_t *next = rec->next;
+            for(retired_t &item : rec->limbo)
+                item.deleter(item.ptr);
+            delete rec;
+            rec = next;
+        }
+    }
+
+    void enter() {
+        record_t *rec = get_record();
+        if(rec->depth++ == 0) {
+            rec->state.store((global_epoch.load(std::memory_order_seq_cst) << 1) | 1, std::memory_order_seq_cst);
+            // keeps the following loads of shared pointers after the store
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    void exit() {
+        record_t *rec = get_record();
+        if(--rec->depth == 0) {
+            rec->state.store(0, std::memory_order_release);
+        }
+    }
+
+    // the object must be unreachable for new readers already
+    void retire(void *ptr, deleter_t deleter) {
+        record_t *rec = get_record();
+        rec->limbo.push_back({ ptr, deleter, global_epoch.load(std::memory_order_seq_cst) });
+        if(rec->limbo.size() >= rec->reclaim_at) {
+            try_advance();
+            reclaim(rec);
+            rec->reclaim_at = rec->limbo.size() + EPOCH_RECLAIM_THRESHOLD;
+        }
+    }
+
+    template<typename T>
+    void retire(T *ptr) {
+        retire(ptr, [](void *p) { delete (T*)p; });
+    }
+
+    // frees the retired objects of this thread as far as possible
+    void collect() {
+        record_t *rec = get_record();
+        try_advance();
+        try_advance();
+        reclaim(rec);
+    }
+
+private:
+    struct retired_t {
+        void *ptr;
+        deleter_t deleter;
+        uint64_t epoch;
+    };
+
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) record_t {
+        // (epoch << 1) | 1 while the owner is in a critical region, 0 otherwise
+        std::atomic<uint64_t> state{0};
+        std::atomic<bool> in_use{true};
+        record_t *next = nullptr;
+        uint32_t depth = 0;
+        size_t reclaim_at = EPOCH_RECLAIM_THRESHOLD;
+        std::vector<retired_t> limbo;
+    };
+
+    // binds a record to the current thread, released on thread exit
+    class threadlocal_record_t {
+    public:
+        threadlocal_record_t() : owner(nullptr), record(nullptr) {}
+
+        ~threadlocal_record_t() {
+            if(record != nullptr) {
+                // retired objects stay in the record for its next owner
+                record->in_use.store(false, std::memory_order_release);
+            }
+        }
+
+        epoch_reclaimer *owner;
+        record_t *record;
+    };
+
+    inline static thread_local threadlocal_record_t threadlocal_record;
+
+private:
+    record_t *get_record() {
+        threadlocal_record_t &tls = threadlocal_record;
+        if(tls.owner == this)
+            return tls.record;
+
+        // a thread is bound to a single reclaimer (normally the global one)
+        assert(tls.owner == nullptr);
+        record_t *rec = records.load(std::memory_order_acquire);
+        for(; rec != nullptr; rec = rec->next) {
+            bool expected = false;
+            if(!rec->in_use.load(std::memory_order_relaxed) && rec->in_use.compare_exchange_strong(expected, true))
+                break;
+        }
+        if(rec == nullptr) {
+            rec = new record_t();
+            rec->next = records.load(std::memory_order_relaxed);
+            while(!records.compare_exchange_weak(rec->next, rec, std::memory_order_release, std::memory_order_relaxed));
+        }
+        tls.owner = this;
+        tls.record = rec;
+        return rec;
+    }
+
+    // advances the global epoch if every active thread has observed it
+    bool try_advance() {
+        uint64_t epoch = global_epoch.load(std::memory_order_seq_cst);
+        for(record_t *rec = records.load(std::memory_order_acquire); rec != nullptr; rec = rec->next) {
+            uint64_t state = rec->state.load(std::memory_order_seq_cst);
+            if((state & 1) && (state >> 1) != epoch)
+                return false;
+        }
+        return global_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+    }
+
+    void reclaim(record_t *rec) {
+        uint64_t epoch = global_epoch.load(std::memory_order_seq_cst);
+        size_t kept = 0;
+        for(size_t i = 0, cnt = rec->limbo.size(); i < cnt; i++) {
+            retired_t item = rec->limbo[i];
+            if(item.epoch + 2 <= epoch)
+                item.deleter(item.ptr);
+            else
+                rec->limbo[kept++] = item;
+        }
+        rec->limbo.resize(kept);
+    }
+
+private:
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64_t> global_epoch;
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<record_t*> records;
+};
+
+inline epoch_reclaimer global_epoch_reclaimer;
+
+// scoped epoch critical region
+class epoch_guard {
+public:
+    epoch_guard(epoch_reclaimer *in_reclaimer = &global_epoch_reclaimer) : reclaimer(in_reclaimer) { reclaimer->enter(); }
+    ~epoch_guard() { reclaimer->exit(); }
+
+private:
+    epoch_reclaimer *reclaimer;
+};
+
+#endif /* EpochReclaimer_h */
@@ -13,6 +13,7 @@
 #include <cassert>
 #include "../LockFree/Mutex.h"
 #include "../Thread/ThreadLocal.h"
+#include "../Thread/Tracer.h"
 #include "../../Platform/PlatformDefine.h"
 
 constexpr size_t PAGE_SIZE_16KB = 16 * 1024;
@@ -52,15 +53,16 @@ public:
     }
     
     void *allocate(size_t size) {
-        threadlocal_info_t &threadlocal = get_threadlocal_info(threadlocal_get_thread_id());
+        threadlocal_info_t &threadlocal = get_threadlocal_info();
         return threadlocal.allocate(size);
     }
     
     void free(void *ptr) {
         uintptr_t base_address = get_base_address(ptr);
         page_t *page = (page_t*)base_address;
-        threadlocal_thread_id thread_id = threadlocal_get_thread_id();
-        if(page->thread_id == thread_id) {
+        // thread ids are recycled, so ownership follows the threadlocal info the page was created by
+        // (a thread that only frees has none and never creates one here)
+        if(page->owner == current_threadlocal_info) {
             page->free(ptr);
         }
         else {
@@ -69,22 +71,24 @@ public:
     }
     
     void collect() {
-        get_threadlocal_info(threadlocal_get_thread_id()).collect();
+        get_threadlocal_info().collect();
     }
     
 private:
+    class threadlocal_info_t;
+    
     class page_t {
     public:
         //static constexpr size_t page_header_size = ((2 * PLATFORM_CACHE_LINE_SIZE + (block_size-1)) & (~(block_size-1)));
         //static constexpr size_t allocatable_page_size = page_size - page_header_size;
         //static constexpr size_t num_blocks_in_page = allocatable_page_size / block_size;
         
-        page_t(uint32_t new_page_block_size = PLATFORM_CACHE_LINE_SIZE) : page_block_size(new_page_block_size) {
+        page_t(threadlocal_info_t *new_owner, uint32_t new_page_block_size = PLATFORM_CACHE_LINE_SIZE) : page_block_size(new_page_block_size) {
             page_header_size = ((2 * PLATFORM_CACHE_LINE_SIZE + (page_block_size-1)) & (~(page_block_size-1)));
             num_blocks_in_page = (page_size - page_header_size) / page_block_size;
             num_allocated = 0;
             void *buffer = (void*)((uintptr_t)this + page_header_size);
-            thread_id = threadlocal_get_thread_id();
+            owner = new_owner;
             local_free_list = (block_t*)buffer;
         }
         
@@ -137,7 +141,7 @@ private:
         friend class memory_pool;
         
         struct alignas(PLATFORM_CACHE_LINE_SIZE) {
-            threadlocal_thread_id thread_id;
+            threadlocal_info_t *owner;
             uint32_t page_block_size;
             uint32_t page_header_size;
             uint32_t num_blocks_in_page;
@@ -195,6 +199,7 @@ private:
         }
         
         void collect(uint32_t block_size_index) {
+            TRACE_SCOPE("memory_pool collect");
             for(size_t i = 0, cnt = filled_pages[block_size_index].size(); i < cnt; i++) {
                 page_t *page = filled_pages[block_size_index].at(i);
                 page->collect();
@@ -208,6 +213,7 @@ private:
         }
         
         page_t *create_new_page(uint32_t new_block_size, uint32_t block_size_index) {
+            TRACE_SCOPE("memory_pool create_new_page");
             void *buffer;
             constexpr size_t alloc_size = page_size < PAGE_SIZE_2MB ? PAGE_SIZE_2MB : page_size;
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32__)
@@ -218,7 +224,7 @@ private:
             std::memset(buffer, 0, alloc_size);
             uint8_t *ptr = (uint8_t*)buffer;
             for(uintptr_t offset = 0; offset < alloc_size; offset += page_size) {
-                page_t *page = new (ptr + offset) page_t(new_block_size);
+                page_t *page = new (ptr + offset) page_t(this, new_block_size);
                 free_pages[block_size_index].push_back(page);
             }
             return free_pages[block_size_index].back();
@@ -243,12 +249,14 @@ private:
                 threadlocal_info = new threadlocal_info_t();
             }
             threadlocal_info->initialize(threadlocal_get_thread_id());
+            current_threadlocal_info = threadlocal_info;
         }
         
         ~threadlocal_initializer_t() {
             scoped_lock<spinlock_mutex> lock{ &memory_pool::mutex };
             free_threadlocal_infos.push_back(threadlocal_info);
             threadlocal_info = nullptr;
+            current_threadlocal_info = nullptr;
         }
         
         threadlocal_info_t *threadlocal_info;
@@ -257,10 +265,12 @@ private:
     inline static spinlock_mutex mutex;
     inline static std::vector<threadlocal_info_t*> free_threadlocal_infos;
     inline static thread_local threadlocal_initializer_t threadlocal_initializer;
+    // set by threadlocal_initializer, readable without constructing it
+    inline static thread_local threadlocal_info_t *current_threadlocal_info = nullptr;
     //inline static thread_local threadlocal_info_t threadlocal_info;
     
 private:
-    threadlocal_info_t& get_threadlocal_info(threadlocal_thread_id thread_id) {
+    threadlocal_info_t& get_threadlocal_info() {
         return *threadlocal_initializer.threadlocal_info;
     }
     
@@ -0,0 +1,310 @@
+//
+//  SharedRegion.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef SharedRegion_h
+#define SharedRegion_h
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include "../../Platform/PlatformDefine.h"
+#include "../../Platform/PlatformSharedMemory.h"
+
+// size of a region page (must be power of 2, page 0 holds the region header)
+#define SHARED_REGION_PAGE_SIZE (64 * 1024)
+
+// page header size, blocks start right after it
+#define SHARED_REGION_PAGE_HEADER_SIZE 64
+
+// number of processes that can be attached at the same time (fits in the ring claim bits)
+#define SHARED_REGION_MAX_PARTICIPANTS 64
+
+// number of named root offsets
+#define SHARED_REGION_NUM_ROOTS 8
+
+#define SHARED_REGION_MAGIC 0x4e4f494745524853ull
+#define SHARED_REGION_VERSION 1
+
+constexpr size_t SHARED_BLOCK_SIZE_LIST[] = {
+    64, 128, 256, 512, 1024, 2048, 4096
+};
+constexpr size_t SHARED_NUM_BLOCK_SIZE = 7;
+
+// Offset pointer (position independent)
+//
+// Holds the distance from the region base, so the same value is valid in
+// every process no matter where the region got mapped. 0 is null (the
+// region header lives there).
+template<typename T>
+struct shared_offset_ptr {
+    uint64_t offset = 0;
+
+    shared_offset_ptr() {}
+    explicit shared_offset_ptr(uint64_t new_offset) : offset(new_offset) {}
+
+    inline T *get(void *base) const { return offset != 0 ? (T*)((uintptr_t)base + offset) : nullptr; }
+    inline explicit operator bool() const { return offset != 0; }
+};
+
+// Shared memory region (position independent block allocator)
+//
+// Pages are carved from a bump cursor and split into blocks of one size
+// class, like memory_pool::page_t; the block size is found from the page
+// header, so free() only needs the offset. Every free list is a Treiber
+// stack of 32-bit offsets with a 32-bit tag against ABA, changed with a
+// single CAS, so a process dying in the middle of allocate()/free() leaves
+// the lists consistent and leaks at most the blocks it was holding.
+// Processes register with attach(); the pid table lets the survivors tell
+// which claims belong to a dead peer.
+class shared_region {
+public:
+    shared_region() {}
+
+    ~shared_region() {
+        detach();
+    }
+
+    shared_region(const shared_region&) = delete;
+    shared_region& operator=(const shared_region&) = delete;
+
+public:
+    // creates and formats a new region (at most 4GB, offsets are 32-bit)
+    bool create(size_t size) {
+        assert(size <= (size_t(1) << 32));
+        if(size < 2 * SHARED_REGION_PAGE_SIZE)
+            return false;
+        size &= ~(size_t)(SHARED_REGION_PAGE_SIZE - 1);
+        if(!memory.create("cpp_playground_shared_region", size))
+            return false;
+        base = memory.get_address();
+        header = new (base) header_t();
+        header->magic = SHARED_REGION_MAGIC;
+        header->version = SHARED_REGION_VERSION;
+        header->page_size = SHARED_REGION_PAGE_SIZE;
+        header->size = size;
+        header->next_page.store(SHARED_REGION_PAGE_SIZE, std::memory_order_release);
+        return true;
+    }
+
+    // maps a region formatted by another process
+    bool open(int fd, size_t size) {
+        if(!memory.open(fd, size))
+            return false;
+        base = memory.get_address();
+        header = (header_t*)base;
+        if(header->magic != SHARED_REGION_MAGIC || header->version != SHARED_REGION_VERSION || header->size > size) {
+            memory.close();
+            base = nullptr;
+            header = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    // registers the calling process, returns false when the table is full
+    // (a forked child inherits the parent's registration and must attach again)
+    bool attach() {
+        uint32_t pid = platform::platform_get_process_id();
+        for(uint32_t i = 0; i < SHARED_REGION_MAX_PARTICIPANTS; i++) {
+            uint32_t expected = 0;
+            if(header->participants[i].pid.compare_exchange_strong(expected, pid, std::memory_order_acq_rel)) {
+                participant_index = i;
+                return true;
+            }
+        }
+        participant_index = -1;
+        return false;
+    }
+
+    // the process must not be in the middle of a ring operation
+    void detach() {
+        if(header != nullptr && participant_index >= 0 && header->participants[participant_index].pid.load(std::memory_order_relaxed) == platform::platform_get_process_id())
+            header->participants[participant_index].pid.store(0, std::memory_order_release);
+        participant_index = -1;
+    }
+
+    inline int get_participant_index() const { return participant_index; }
+
+    // an empty entry counts as dead
+    bool is_participant_alive(uint32_t index) const {
+        uint32_t pid = header->participants[index].pid.load(std::memory_order_acquire);
+        return pid != 0 && platform::platform_is_process_alive(pid);
+    }
+
+    // frees the entries of exited processes, call it only after every ring
+    // has been recovered (a reused index would make old claims look alive)
+    uint32_t release_dead_participants() {
+        uint32_t count = 0;
+        for(uint32_t i = 0; i < SHARED_REGION_MAX_PARTICIPANTS; i++) {
+            uint32_t pid = header->participants[i].pid.load(std::memory_order_acquire);
+            if(pid != 0 && !platform::platform_is_process_alive(pid) && header->participants[i].pid.compare_exchange_strong(pid, 0, std::memory_order_acq_rel))
+                count++;
+        }
+        return count;
+    }
+
+    // returns the offset of a block, or 0 when out of memory
+    uint64_t allocate(size_t size) {
+        int index = get_block_size_index(size);
+        if(index < 0)
+            return 0;
+        uint64_t offset = pop_block(index);
+        if(offset == 0)
+            offset = create_new_page(index);
+        return offset;
+    }
+
+    void free(uint64_t offset) {
+        assert(offset >= SHARED_REGION_PAGE_SIZE && offset < header->size);
+        const page_t *page = (const page_t*)((uintptr_t)base + (offset & ~(uint64_t)(SHARED_REGION_PAGE_SIZE - 1)));
+        push_block(page->block_size_index, offset);
+    }
+
+    // contiguous page-aligned memory for long-lived structures, never freed
+    uint64_t allocate_pages(size_t size) {
+        uint64_t aligned_size = (size + SHARED_REGION_PAGE_SIZE - 1) & ~(uint64_t)(SHARED_REGION_PAGE_SIZE - 1);
+        // advances only when the pages fit, a failed request leaves the rest usable
+        uint64_t offset = header->next_page.load(std::memory_order_relaxed);
+        do {
+            if(aligned_size > header->size - offset)
+                return 0;
+        }
+        while(!header->next_page.compare_exchange_weak(offset, offset + aligned_size, std::memory_order_relaxed));
+        return offset;
+    }
+
+    inline void *get_base() const { return base; }
+    inline size_t get_size() const { return base != nullptr ? (size_t)header->size : 0; }
+    inline int get_fd() const { return memory.get_fd(); }
+
+    template<typename T = void>
+    inline T *get_pointer(uint64_t offset) const { return offset != 0 ? (T*)((uintptr_t)base + offset) : nullptr; }
+
+    inline uint64_t get_offset(const void *ptr) const { return ptr != nullptr ? (uint64_t)((uintptr_t)ptr - (uintptr_t)base) : 0; }
+
+    // roots let processes find the structures built by the creator
+    void set_root(uint32_t index, uint64_t offset) {
+        header->roots[index].store(offset, std::memory_order_release);
+    }
+
+    uint64_t get_root(uint32_t index) const {
+        return header->roots[index].load(std::memory_order_acquire);
+    }
+
+    // approximate bytes taken by pages (not thread-safe against growth)
+    uint64_t debug_used_size() const {
+        uint64_t used = header->next_page.load(std::memory_order_relaxed);
+        return used < header->size ? used : header->size;
+    }
+
+private:
+    // head of a free list : offset in the low half, ABA tag in the high half
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) free_list_t {
+        std::atomic<uint64_t> head{0};
+    };
+
+    struct participant_t {
+        std::atomic<uint32_t> pid{0};
+    };
+
+    // page 0 of the region
+    struct header_t {
+        uint64_t magic = 0;
+        uint32_t version = 0;
+        uint32_t page_size = 0;
+        uint64_t size = 0;
+        alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64_t> next_page{0};
+        free_list_t free_lists[SHARED_NUM_BLOCK_SIZE];
+        alignas(PLATFORM_CACHE_LINE_SIZE) participant_t participants[SHARED_REGION_MAX_PARTICIPANTS];
+        alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64_t> roots[SHARED_REGION_NUM_ROOTS] = {};
+    };
+
+    struct page_t {
+        uint32_t block_size_index;
+        uint32_t num_blocks;
+    };
+
+private:
+    static int get_block_size_index(size_t size) {
+        for(size_t i = 0; i < SHARED_NUM_BLOCK_SIZE; i++) {
+            if(size <= SHARED_BLOCK_SIZE_LIST[i])
+                return (int)i;
+        }
+        return -1;
+    }
+
+    // the first word of a free block links to the next one
+    inline std::atomic<uint32_t> &get_next(uint64_t offset) const {
+        return *(std::atomic<uint32_t>*)((uintptr_t)base + offset);
+    }
+
+    uint64_t pop_block(int index) {
+        std::atomic<uint64_t> &head = header->free_lists[index].head;
+        uint64_t old_head = head.load(std::memory_order_acquire);
+        for(;;) {
+            uint32_t offset = (uint32_t)old_head;
+            if(offset == 0)
+                return 0;
+            // may read a block that was just popped by someone else, the tag fails the CAS then
+            uint64_t new_head = ((old_head >> 32) + 1) << 32 | get_next(offset).load(std::memory_order_relaxed);
+            if(head.compare_exchange_weak(old_head, new_head, std::memory_order_acq_rel, std::memory_order_acquire))
+                return offset;
+        }
+    }
+
+    void push_block(int index, uint64_t offset) {
+        push_chain(index, offset, offset);
+    }
+
+    // pushes first..last, already linked together
+    void push_chain(int index, uint64_t first, uint64_t last) {
+        std::atomic<uint64_t> &head = header->free_lists[index].head;
+        uint64_t old_head = head.load(std::memory_order_relaxed);
+        for(;;) {
+            get_next(last).store((uint32_t)old_head, std::memory_order_relaxed);
+            uint64_t new_head = ((old_head >> 32) + 1) << 32 | first;
+            if(head.compare_exchange_weak(old_head, new_head, std::memory_order_release, std::memory_order_relaxed))
+                return;
+        }
+    }
+
+    // keeps the first block, and publishes the rest with one CAS
+    uint64_t create_new_page(int index) {
+        uint64_t page_offset = allocate_pages(SHARED_REGION_PAGE_SIZE);
+        if(page_offset == 0)
+            return 0;
+        uint32_t block_size = (uint32_t)SHARED_BLOCK_SIZE_LIST[index];
+        page_t *page = get_pointer<page_t>(page_offset);
+        page->block_size_index = (uint32_t)index;
+        page->num_blocks = (SHARED_REGION_PAGE_SIZE - SHARED_REGION_PAGE_HEADER_SIZE) / block_size;
+
+        uint64_t first = page_offset + SHARED_REGION_PAGE_HEADER_SIZE;
+        uint64_t last = first + (uint64_t)(page->num_blocks - 1) * block_size;
+        if(page->num_blocks > 1) {
+            for(uint64_t offset = first + block_size; offset < last; offset += block_size)
+                get_next(offset).store((uint32_t)(offset + block_size), std::memory_order_relaxed);
+            push_chain(index, first + block_size, last);
+        }
+        return first;
+    }
+
+private:
+    platform::platform_shared_memory memory;
+    void *base = nullptr;
+    header_t *header = nullptr;
+    int participant_index = -1;
+
+    static_assert(sizeof(header_t) <= SHARED_REGION_PAGE_SIZE, "The region header must fit in a page!");
+    static_assert(sizeof(page_t) <= SHARED_REGION_PAGE_HEADER_SIZE, "The page header is too large!");
+    static_assert((SHARED_REGION_PAGE_SIZE & (SHARED_REGION_PAGE_SIZE - 1)) == 0, "The page size must be power of 2!");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared atomics must be address-free!");
+};
+
+#endif /* SharedRegion_h */
@@ -9,7 +9,24 @@
 #define Shared_h
 
 #include "Memory/MemoryPool.h"
+#include "Memory/EpochReclaimer.h"
+#include "Memory/SharedRegion.h"
 #include "LockFree/LockFreeStack.h"
+#include "LockFree/BoundedStack.h"
 #include "LockFree/Mutex.h"
+#include "LockFree/SeqLock.h"
+#include "LockFree/AsymmetricLock.h"
+#include "LockFree/ConcurrentHashMap.h"
+#include "LockFree/SkipList.h"
+#include "LockFree/MPSCQueue.h"
+#include "LockFree/EventCount.h"
+#include "LockFree/FlatCombining.h"
+#include "LockFree/ShardedCounter.h"
+#include "LockFree/MultiQueue.h"
+#include "LockFree/SharedRingQueue.h"
+#include "Thread/ParkingLot.h"
+#include "Thread/ParkingPrimitives.h"
+#include "Thread/ThreadPool.h"
+#include "Thread/ParallelAlgorithm.h"
 
 #endif /* Shared_h */
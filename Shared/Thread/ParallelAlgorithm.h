@@ -0,0 +1,160 @@
+//
+//  ParallelAlgorithm.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef ParallelAlgorithm_h
+#define ParallelAlgorithm_h
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "ThreadPool.h"
+
+// minimum number of elements handled by a single task
+#define PARALLEL_DEFAULT_GRAIN_SIZE 4096
+
+// number of tasks per participating thread (load balancing)
+#define PARALLEL_TASKS_PER_THREAD 4
+
+// bits sorted per radix sort pass
+#define PARALLEL_RADIX_BITS 8
+#define PARALLEL_RADIX_BUCKETS (1 << PARALLEL_RADIX_BITS)
+
+// below this count parallel_radix_sort falls back to std::sort
+#define PARALLEL_SORT_MIN_COUNT 65536
+
+// number of tasks for count elements
+inline size_t parallel_get_task_count(size_t count, size_t grain_size, thread_pool &pool) {
+    if(grain_size == 0)
+        grain_size = 1;
+    size_t max_tasks = ((size_t)pool.get_worker_count() + 1) * PARALLEL_TASKS_PER_THREAD;
+    size_t num_tasks = (count + grain_size - 1) / grain_size;
+    return std::max<size_t>(1, std::min(num_tasks, max_tasks));
+}
+
+// start of the task_index-th of num_tasks even chunks of [begin, end)
+inline size_t parallel_get_chunk_begin(size_t begin, size_t end, size_t num_tasks, size_t task_index) {
+    return begin + (end - begin) * task_index / num_tasks;
+}
+
+// calls func(chunk_begin, chunk_end) on even chunks of [begin, end)
+template<typename func_t>
+void parallel_for_range(size_t begin, size_t end, func_t func, size_t grain_size = PARALLEL_DEFAULT_GRAIN_SIZE, thread_pool &pool = get_global_thread_pool()) {
+    if(begin >= end)
+        return;
+    size_t num_tasks = parallel_get_task_count(end - begin, grain_size, pool);
+    if(num_tasks == 1) {
+        func(begin, end);
+        return;
+    }
+    pool.run(num_tasks, [&](size_t task_index) {
+        func(parallel_get_chunk_begin(begin, end, num_tasks, task_index), parallel_get_chunk_begin(begin, end, num_tasks, task_index + 1));
+    });
+}
+
+// calls func(index) for every index in [begin, end)
+template<typename func_t>
+void parallel_for(size_t begin, size_t end, func_t func, size_t grain_size = PARALLEL_DEFAULT_GRAIN_SIZE, thread_pool &pool = get_global_thread_pool()) {
+    parallel_for_range(begin, end, [&](size_t chunk_begin, size_t chunk_end) {
+        for(size_t i = chunk_begin; i < chunk_end; i++)
+            func(i);
+    }, grain_size, pool);
+}
+
+// reduces [begin, end) : each chunk is folded with map_func(chunk_begin, chunk_end) -> T,
+// then the chunk results are combined in order with reduce_func(T, T) -> T.
+template<typename T, typename map_func_t, typename reduce_func_t>
+T parallel_reduce(size_t begin, size_t end, T identity, map_func_t map_func, reduce_func_t reduce_func, size_t grain_size = PARALLEL_DEFAULT_GRAIN_SIZE, thread_pool &pool = get_global_thread_pool()) {
+    if(begin >= end)
+        return identity;
+    size_t num_tasks = parallel_get_task_count(end - begin, grain_size, pool);
+    std::vector<T> partials(num_tasks, identity);
+    pool.run(num_tasks, [&](size_t task_index) {
+        partials[task_index] = map_func(parallel_get_chunk_begin(begin, end, num_tasks, task_index), parallel_get_chunk_begin(begin, end, num_tasks, task_index + 1));
+    });
+    T result = identity;
+    for(size_t i = 0; i < num_tasks; i++)
+        result = reduce_func(result, partials[i]);
+    return result;
+}
+
+// Parallel LSD radix sort (integer keys)
+//
+// Every pass counts the digits of each chunk in parallel, turns the
+// histograms into per-chunk output offsets (digit-major, chunk-minor, which
+// keeps the sort stable), then scatters the chunks in parallel. Signed keys
+// have their sign bit flipped, and passes where every key has the same
+// digit are skipped.
+template<typename T>
+void parallel_radix_sort(T *data, size_t count, thread_pool &pool = get_global_thread_pool()) {
+    static_assert(std::is_integral<T>::value, "parallel_radix_sort needs integer keys!");
+    typedef typename std::make_unsigned<T>::type key_t;
+    constexpr key_t sign_flip = std::is_signed<T>::value ? (key_t)((key_t)1 << (sizeof(T) * 8 - 1)) : 0;
+    constexpr uint32_t num_passes = (sizeof(T) * 8 + PARALLEL_RADIX_BITS - 1) / PARALLEL_RADIX_BITS;
+
+    if(count < PARALLEL_SORT_MIN_COUNT) {
+        std::sort(data, data + count);
+        return;
+    }
+
+    std::unique_ptr<T[]> buffer(new T[count]);
+    size_t num_tasks = parallel_get_task_count(count, PARALLEL_DEFAULT_GRAIN_SIZE, pool);
+    std::vector<size_t> offsets(num_tasks * PARALLEL_RADIX_BUCKETS);
+    T *src = data;
+    T *dst = buffer.get();
+
+    for(uint32_t pass = 0; pass < num_passes; pass++) {
+        uint32_t shift = pass * PARALLEL_RADIX_BITS;
+        auto get_digit = [shift](T value) -> size_t {
+            return (size_t)((((key_t)value ^ sign_flip) >> shift) & (PARALLEL_RADIX_BUCKETS - 1));
+        };
+
+        pool.run(num_tasks, [&](size_t task_index) {
+            size_t *histogram = &offsets[task_index * PARALLEL_RADIX_BUCKETS];
+            std::fill(histogram, histogram + PARALLEL_RADIX_BUCKETS, 0);
+            size_t chunk_end = parallel_get_chunk_begin(0, count, num_tasks, task_index + 1);
+            for(size_t i = parallel_get_chunk_begin(0, count, num_tasks, task_index); i < chunk_end; i++)
+                histogram[get_digit(src[i])]++;
+        });
+
+        // exclusive prefix sum in (digit, chunk) order
+        size_t total = 0;
+        bool single_digit = false;
+        for(size_t digit = 0; digit < PARALLEL_RADIX_BUCKETS; digit++) {
+            size_t digit_begin = total;
+            for(size_t task_index = 0; task_index < num_tasks; task_index++) {
+                size_t &offset = offsets[task_index * PARALLEL_RADIX_BUCKETS + digit];
+                size_t chunk_count = offset;
+                offset = total;
+                total += chunk_count;
+            }
+            if(total - digit_begin == count)
+                single_digit = true;
+        }
+        if(single_digit)
+            continue;
+
+        pool.run(num_tasks, [&](size_t task_index) {
+            size_t *offset = &offsets[task_index * PARALLEL_RADIX_BUCKETS];
+            size_t chunk_end = parallel_get_chunk_begin(0, count, num_tasks, task_index + 1);
+            for(size_t i = parallel_get_chunk_begin(0, count, num_tasks, task_index); i < chunk_end; i++)
+                dst[offset[get_digit(src[i])]++] = src[i];
+        });
+        std::swap(src, dst);
+    }
+
+    if(src != data) {
+        parallel_for_range(0, count, [&](size_t chunk_begin, size_t chunk_end) {
+            std::memcpy(data + chunk_begin, src + chunk_begin, (chunk_end - chunk_begin) * sizeof(T));
+        }, PARALLEL_DEFAULT_GRAIN_SIZE, pool);
+    }
+}
+
+#endif /* ParallelAlgorithm_h */
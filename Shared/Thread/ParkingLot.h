@@ -0,0 +1,256 @@
+//
+//  ParkingLot.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef ParkingLot_h
+#define ParkingLot_h
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include "../LockFree/Mutex.h"
+#include "../../Platform/PlatformDefine.h"
+#include "../../Platform/PlatformFutex.h"
+
+// number of wait queue buckets (must be power of 2)
+#define PARKING_LOT_BUCKET_COUNT 256
+
+// result of parking_lot::park
+enum class park_result {
+    unparked,
+    invalid,
+    timed_out
+};
+
+// result passed to the callback of unpark_one (called with the bucket locked)
+struct unpark_result {
+    bool did_unpark;
+    // another thread is still parked on the same address
+    bool may_have_more;
+};
+
+// Parking lot (address-keyed wait queues, WebKit style)
+//
+// Threads park on any address, so a synchronization object only needs the
+// few bits of state it checks in validate(); the queues live in a global
+// hash table of buckets. validate() and the unpark callbacks run with the
+// bucket locked, which makes "check the state, then sleep" atomic with
+// respect to unparking. Each parked thread sleeps on its own futex word.
+class parking_lot {
+public:
+    // parks the calling thread on addr if validate() returns true.
+    // before_sleep() runs after the thread is queued (e.g. to release a lock).
+    template<typename validate_t, typename before_sleep_t>
+    park_result park(const void *addr, validate_t validate, before_sleep_t before_sleep, int64_t timeout_ns = -1) {
+        thread_data_t &self = get_thread_data();
+        bucket_t &bucket = get_bucket(addr);
+        
+        bucket.mutex.lock();
+        if(!validate()) {
+            bucket.mutex.unlock();
+            return park_result::invalid;
+        }
+        self.addr = addr;
+        self.next = nullptr;
+        self.signaled.store(0, std::memory_order_relaxed);
+        if(bucket.tail != nullptr)
+            bucket.tail->next = &self;
+        else
+            bucket.head = &self;
+        bucket.tail = &self;
+        bucket.mutex.unlock();
+        
+        before_sleep();
+        
+        if(wait_signal(self, timeout_ns))
+            return park_result::unparked;
+        
+        // timed out, leave the queue unless an unparker already took us out of it
+        bucket.mutex.lock();
+        bool dequeued = remove_thread(bucket, &self);
+        bucket.mutex.unlock();
+        if(dequeued)
+            return park_result::timed_out;
+        
+        // the unparker owns our node until it signals
+        wait_signal(self, -1);
+        return park_result::unparked;
+    }
+    
+    template<typename validate_t>
+    park_result park(const void *addr, validate_t validate, int64_t timeout_ns = -1) {
+        return park(addr, validate, []() {}, timeout_ns);
+    }
+    
+    // wakes the oldest thread parked on addr, callback(unpark_result) runs with the bucket locked
+    template<typename callback_t>
+    bool unpark_one(const void *addr, callback_t callback) {
+        bucket_t &bucket = get_bucket(addr);
+        bucket.mutex.lock();
+        thread_data_t *prev = nullptr;
+        thread_data_t *target = bucket.head;
+        while(target != nullptr && target->addr != addr) {
+            prev = target;
+            target = target->next;
+        }
+        bool may_have_more = false;
+        if(target != nullptr) {
+            unlink_thread(bucket, prev, target);
+            add_ref(target);
+            for(thread_data_t *node = target->next; node != nullptr; node = node->next) {
+                if(node->addr == addr) {
+                    may_have_more = true;
+                    break;
+                }
+            }
+        }
+        callback(unpark_result{ target != nullptr, may_have_more });
+        bucket.mutex.unlock();
+        
+        if(target != nullptr) {
+            signal(target);
+            release_ref(target);
+        }
+        return target != nullptr;
+    }
+    
+    bool unpark_one(const void *addr) {
+        return unpark_one(addr, [](unpark_result) {});
+    }
+    
+    // wakes every thread parked on addr, returns the number of woken threads
+    size_t unpark_all(const void *addr) {
+        bucket_t &bucket = get_bucket(addr);
+        thread_data_t *woken = nullptr;
+        size_t count = 0;
+        
+        bucket.mutex.lock();
+        thread_data_t *prev = nullptr;
+        thread_data_t *node = bucket.head;
+        while(node != nullptr) {
+            thread_data_t *next = node->next;
+            if(node->addr == addr) {
+                unlink_thread(bucket, prev, node);
+                add_ref(node);
+                node->next = woken;
+                woken = node;
+                count++;
+            }
+            else {
+                prev = node;
+            }
+            node = next;
+        }
+        bucket.mutex.unlock();
+        
+        while(woken != nullptr) {
+            // read next before signaling, the woken thread reuses its node
+            thread_data_t *next = woken->next;
+            signal(woken);
+            release_ref(woken);
+            woken = next;
+        }
+        return count;
+    }
+    
+private:
+    // per-thread wait node, reference counted so that an unparker can still
+    // wake its futex after the woken thread has seen the signal and exited
+    struct thread_data_t {
+        std::atomic<uint32_t> signaled{0};
+        std::atomic<uint32_t> ref_count{1};
+        const void *addr = nullptr;
+        thread_data_t *next = nullptr;
+    };
+    
+    // owns the thread's reference
+    struct thread_data_holder_t {
+        thread_data_t *data = new thread_data_t();
+        ~thread_data_holder_t() { release_ref(data); }
+    };
+    
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) bucket_t {
+        spinlock_mutex mutex;
+        thread_data_t *head = nullptr;
+        thread_data_t *tail = nullptr;
+    };
+    
+    static thread_data_t &get_thread_data() {
+        thread_local thread_data_holder_t holder;
+        return *holder.data;
+    }
+    
+    // taken with the bucket locked, while the target is still parked
+    static inline void add_ref(thread_data_t *data) {
+        data->ref_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    static inline void release_ref(thread_data_t *data) {
+        if(data->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete data;
+    }
+    
+    inline bucket_t &get_bucket(const void *addr) {
+        uint64_t hash = (uint64_t)(uintptr_t)addr * 0x9E3779B97F4A7C15ull;
+        return buckets[(hash >> 32) & (PARKING_LOT_BUCKET_COUNT - 1)];
+    }
+    
+    static void unlink_thread(bucket_t &bucket, thread_data_t *prev, thread_data_t *node) {
+        if(prev != nullptr)
+            prev->next = node->next;
+        else
+            bucket.head = node->next;
+        if(bucket.tail == node)
+            bucket.tail = prev;
+    }
+    
+    static bool remove_thread(bucket_t &bucket, thread_data_t *target) {
+        thread_data_t *prev = nullptr;
+        for(thread_data_t *node = bucket.head; node != nullptr; prev = node, node = node->next) {
+            if(node == target) {
+                unlink_thread(bucket, prev, node);
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    static void signal(thread_data_t *target) {
+        target->signaled.store(1, std::memory_order_release);
+#if SUPPORTS_PLATFORM_FUTEX
+        platform::platform_futex_wake_one(&target->signaled);
+#endif
+    }
+    
+    // returns false on timeout (timeout_ns < 0 : infinite)
+    static bool wait_signal(thread_data_t &self, int64_t timeout_ns) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(timeout_ns);
+        while(self.signaled.load(std::memory_order_acquire) == 0) {
+            int64_t remaining_ns = -1;
+            if(timeout_ns >= 0) {
+                remaining_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now()).count();
+                if(remaining_ns <= 0)
+                    return false;
+            }
+#if SUPPORTS_PLATFORM_FUTEX
+            platform::platform_futex_wait(&self.signaled, 0, remaining_ns);
+#else
+            std::this_thread::yield();
+#endif
+        }
+        return true;
+    }
+    
+private:
+    bucket_t buckets[PARKING_LOT_BUCKET_COUNT];
+    
+    static_assert((PARKING_LOT_BUCKET_COUNT & (PARKING_LOT_BUCKET_COUNT - 1)) == 0, "The bucket count must be power of 2!");
+};
+
+inline parking_lot global_parking_lot;
+
+#endif /* ParkingLot_h */
@@ -0,0 +1,180 @@
+//
+//  ParkingPrimitives.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef ParkingPrimitives_h
+#define ParkingPrimitives_h
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "ParkingLot.h"
+
+// remaining time until the deadline for a park call (-1 : infinite, 0 : expired)
+inline int64_t parking_remaining_ns(std::chrono::steady_clock::time_point deadline, int64_t timeout_ns) {
+    if(timeout_ns < 0)
+        return -1;
+    int64_t remaining_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now()).count();
+    return remaining_ns > 0 ? remaining_ns : 0;
+}
+
+// condition variable (one byte, works with any lock that has lock()/unlock())
+class parking_condition {
+public:
+    template<typename lock_t>
+    void wait(lock_t &lock) {
+        wait_for(lock, -1);
+    }
+    
+    template<typename lock_t, typename predicate_t>
+    void wait(lock_t &lock, predicate_t predicate) {
+        while(!predicate())
+            wait(lock);
+    }
+    
+    // returns false on timeout (the lock is held again either way)
+    template<typename lock_t>
+    bool wait_for(lock_t &lock, int64_t timeout_ns) {
+        park_result result = global_parking_lot.park(this, [this]() {
+            has_waiters.store(1, std::memory_order_relaxed);
+            return true;
+        }, [&lock]() {
+            lock.unlock();
+        }, timeout_ns);
+        lock.lock();
+        return result != park_result::timed_out;
+    }
+    
+    void notify_one() {
+        if(has_waiters.load(std::memory_order_relaxed) == 0)
+            return;
+        global_parking_lot.unpark_one(this, [this](unpark_result result) {
+            has_waiters.store(result.may_have_more ? 1 : 0, std::memory_order_relaxed);
+        });
+    }
+    
+    void notify_all() {
+        if(has_waiters.load(std::memory_order_relaxed) == 0)
+            return;
+        has_waiters.store(0, std::memory_order_relaxed);
+        global_parking_lot.unpark_all(this);
+    }
+    
+private:
+    std::atomic<uint8_t> has_waiters{0};
+};
+
+// manual-reset event (one byte)
+class parking_event {
+public:
+    parking_event(bool initial_state = false) : state(initial_state ? SET : 0) {}
+    
+    void set() {
+        if(state.exchange(SET, std::memory_order_acq_rel) & HAS_WAITERS)
+            global_parking_lot.unpark_all(this);
+    }
+    
+    void reset() {
+        state.fetch_and((uint8_t)~SET, std::memory_order_relaxed);
+    }
+    
+    bool is_set() const {
+        return (state.load(std::memory_order_acquire) & SET) != 0;
+    }
+    
+    void wait() {
+        wait_for(-1);
+    }
+    
+    // returns false on timeout
+    bool wait_for(int64_t timeout_ns) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(timeout_ns);
+        for(;;) {
+            uint8_t s = state.load(std::memory_order_acquire);
+            if(s & SET)
+                return true;
+            if(!(s & HAS_WAITERS) && !state.compare_exchange_weak(s, s | HAS_WAITERS, std::memory_order_relaxed))
+                continue;
+            
+            int64_t remaining_ns = parking_remaining_ns(deadline, timeout_ns);
+            if(remaining_ns == 0)
+                return false;
+            global_parking_lot.park(this, [this]() {
+                return state.load(std::memory_order_relaxed) == HAS_WAITERS;
+            }, remaining_ns);
+        }
+    }
+    
+private:
+    static constexpr uint8_t SET = 1;
+    static constexpr uint8_t HAS_WAITERS = 2;
+    
+    std::atomic<uint8_t> state;
+};
+
+// counting semaphore (one word : 31-bit count and a waiter bit)
+class parking_semaphore {
+public:
+    parking_semaphore(uint32_t initial_count = 0) : state(initial_count) {}
+    
+    bool try_acquire() {
+        uint32_t s = state.load(std::memory_order_relaxed);
+        while((s & COUNT_MASK) > 0) {
+            if(state.compare_exchange_weak(s, s - 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+    
+    void acquire() {
+        acquire_for(-1);
+    }
+    
+    // returns false on timeout
+    bool acquire_for(int64_t timeout_ns) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(timeout_ns);
+        for(;;) {
+            uint32_t s = state.load(std::memory_order_relaxed);
+            if((s & COUNT_MASK) > 0) {
+                if(state.compare_exchange_weak(s, s - 1, std::memory_order_acquire, std::memory_order_relaxed))
+                    return true;
+                continue;
+            }
+            if(!(s & HAS_WAITERS) && !state.compare_exchange_weak(s, s | HAS_WAITERS, std::memory_order_relaxed))
+                continue;
+            
+            int64_t remaining_ns = parking_remaining_ns(deadline, timeout_ns);
+            if(remaining_ns == 0)
+                return false;
+            global_parking_lot.park(this, [this]() {
+                return state.load(std::memory_order_relaxed) == HAS_WAITERS;
+            }, remaining_ns);
+        }
+    }
+    
+    void release(uint32_t count = 1) {
+        uint32_t s = state.fetch_add(count, std::memory_order_release);
+        if(!(s & HAS_WAITERS))
+            return;
+        for(uint32_t i = 0; i < count; i++) {
+            // the last parked thread takes the waiter bit with it
+            bool woken = global_parking_lot.unpark_one(this, [this](unpark_result result) {
+                if(!result.may_have_more)
+                    state.fetch_and(COUNT_MASK, std::memory_order_relaxed);
+            });
+            if(!woken)
+                break;
+        }
+    }
+    
+private:
+    static constexpr uint32_t HAS_WAITERS = 0x80000000u;
+    static constexpr uint32_t COUNT_MASK = 0x7FFFFFFFu;
+    
+    std::atomic<uint32_t> state;
+};
+
+#endif /* ParkingPrimitives_h */
@@ -8,18 +8,315 @@
 #ifndef ThreadLocal_h
 #define ThreadLocal_h
 
+#include <algorithm>
 #include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include "../../Platform/PlatformDefine.h"
+
+// number of per-thread slots in a chunk of threadlocal<T> (must be power of 2)
+#define THREADLOCAL_CHUNK_SIZE 64
+
+// maximum number of chunks of threadlocal<T> (ids beyond get an unindexed instance)
+#define THREADLOCAL_MAX_CHUNKS 64
 
 typedef uint32_t threadlocal_thread_id;
 
-inline thread_local threadlocal_thread_id __tls_thread_id = 0;
-inline std::atomic<threadlocal_thread_id> __global_thread_id_counter;
+// id of a thread that hasn't asked for one yet
+constexpr threadlocal_thread_id THREADLOCAL_INVALID_THREAD_ID = UINT32_MAX;
+
+// id of a thread whose id has been released on exit (late thread_local destructors)
+constexpr threadlocal_thread_id THREADLOCAL_EXITED_THREAD_ID = UINT32_MAX - 1;
+
+typedef void (*threadlocal_exit_callback_t)(threadlocal_thread_id thread_id, void *context);
+
+inline thread_local threadlocal_thread_id __tls_thread_id = THREADLOCAL_INVALID_THREAD_ID;
+
+// Thread registry
+//
+// Hands out dense thread ids (the lowest free one, starting at 0) and takes
+// them back when the thread exits, so ids can index per-thread arrays sized
+// by the number of live threads. Exit callbacks run on the exiting thread
+// before its id is released; remove_exit_callback() waits for the running
+// ones, so the context can be destroyed right after it returns.
+class thread_registry {
+public:
+    // registers the calling thread (slow path of threadlocal_get_thread_id)
+    threadlocal_thread_id register_current_thread() {
+        threadlocal_thread_id id;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(free_ids.size() > 0) {
+                std::pop_heap(free_ids.begin(), free_ids.end(), std::greater<threadlocal_thread_id>());
+                id = free_ids.back();
+                free_ids.pop_back();
+            }
+            else {
+                id = (threadlocal_thread_id)threads.size();
+                threads.push_back(live_thread_t());
+            }
+            threads[id].alive = true;
+            threads[id].native_id = std::this_thread::get_id();
+            live_count.store(live_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            id_capacity.store((uint32_t)threads.size(), std::memory_order_release);
+        }
+        __tls_thread_id = id;
+        get_exit_guard().registered = true;
+        return id;
+    }
+    
+    // callback for every thread exit (runs on the exiting thread, must not add or remove callbacks),
+    // returns a handle for remove_exit_callback
+    uint64_t add_exit_callback(threadlocal_exit_callback_t callback, void *context) {
+        std::unique_lock<std::shared_mutex> lock(callback_mutex);
+        uint64_t handle = ++last_callback_handle;
+        exit_callbacks.push_back({ handle, callback, context });
+        return handle;
+    }
+    
+    void remove_exit_callback(uint64_t handle) {
+        std::unique_lock<std::shared_mutex> lock(callback_mutex);
+        exit_callbacks.erase(std::remove_if(exit_callbacks.begin(), exit_callbacks.end(), [handle](const exit_callback_entry_t &entry) {
+            return entry.handle == handle;
+        }), exit_callbacks.end());
+    }
+    
+    // callback for the exit of the calling thread only (run in reverse order of registration)
+    void at_thread_exit(threadlocal_exit_callback_t callback, void *context);
+    
+    // snapshot of the ids of live threads
+    std::vector<threadlocal_thread_id> get_live_threads() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<threadlocal_thread_id> result;
+        result.reserve(live_count.load(std::memory_order_relaxed));
+        for(size_t i = 0; i < threads.size(); i++) {
+            if(threads[i].alive)
+                result.push_back((threadlocal_thread_id)i);
+        }
+        return result;
+    }
+    
+    uint32_t get_live_thread_count() const {
+        return live_count.load(std::memory_order_relaxed);
+    }
+    
+    // every id handed out so far is below this
+    uint32_t get_id_capacity() const {
+        return id_capacity.load(std::memory_order_acquire);
+    }
+    
+private:
+    struct live_thread_t {
+        bool alive = false;
+        std::thread::id native_id;
+    };
+    
+    struct exit_callback_entry_t {
+        uint64_t handle;
+        threadlocal_exit_callback_t callback;
+        void *context;
+    };
+    
+    // destroyed with the thread_local objects of the thread
+    struct threadlocal_exit_guard_t {
+        bool registered = false;
+        std::vector<std::pair<threadlocal_exit_callback_t, void*>> callbacks;
+        
+        ~threadlocal_exit_guard_t();
+    };
+    
+    static threadlocal_exit_guard_t &get_exit_guard() {
+        thread_local threadlocal_exit_guard_t guard;
+        return guard;
+    }
+    
+    void unregister_current_thread(threadlocal_exit_guard_t &guard) {
+        threadlocal_thread_id id = __tls_thread_id;
+        for(size_t i = guard.callbacks.size(); i > 0; i--)
+            guard.callbacks[i - 1].first(id, guard.callbacks[i - 1].second);
+        guard.callbacks.clear();
+        
+        {
+            // held while the callbacks run, exiting threads don't block each other
+            std::shared_lock<std::shared_mutex> lock(callback_mutex);
+            for(exit_callback_entry_t &entry : exit_callbacks)
+                entry.callback(id, entry.context);
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            threads[id].alive = false;
+            threads[id].native_id = std::thread::id();
+            free_ids.push_back(id);
+            std::push_heap(free_ids.begin(), free_ids.end(), std::greater<threadlocal_thread_id>());
+            live_count.store(live_count.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        }
+        __tls_thread_id = THREADLOCAL_EXITED_THREAD_ID;
+    }
+    
+private:
+    std::mutex mutex;
+    std::vector<live_thread_t> threads;
+    // min-heap, the lowest id is reused first
+    std::vector<threadlocal_thread_id> free_ids;
+    // guards exit_callbacks and last_callback_handle
+    std::shared_mutex callback_mutex;
+    std::vector<exit_callback_entry_t> exit_callbacks;
+    uint64_t last_callback_handle = 0;
+    std::atomic<uint32_t> live_count{0};
+    std::atomic<uint32_t> id_capacity{0};
+};
+
+inline thread_registry global_thread_registry;
+
+inline thread_registry::threadlocal_exit_guard_t::~threadlocal_exit_guard_t() {
+    if(registered)
+        global_thread_registry.unregister_current_thread(*this);
+}
 
 inline threadlocal_thread_id threadlocal_get_thread_id() {
-    if(__tls_thread_id == 0) {
-        __tls_thread_id = __global_thread_id_counter.fetch_add(1) + 1;
+    threadlocal_thread_id id = __tls_thread_id;
+    if(id == THREADLOCAL_INVALID_THREAD_ID) {
+        id = global_thread_registry.register_current_thread();
     }
-    return __tls_thread_id;
+    return id;
+}
+
+inline void thread_registry::at_thread_exit(threadlocal_exit_callback_t callback, void *context) {
+    // too late once the thread has released its id
+    if(threadlocal_get_thread_id() == THREADLOCAL_EXITED_THREAD_ID)
+        return;
+    get_exit_guard().callbacks.push_back({ callback, context });
 }
 
+// Enumerable thread-local storage (TBB combinable style)
+//
+// local() lazily creates a cache-line-aligned instance for the calling
+// thread, found through a chunked table indexed by the dense thread id.
+// Every instance is also linked into a list that for_each() and combine()
+// walk. When a thread exits, its slot is detached so the recycled id gets
+// a fresh instance, but the old one stays in the list until clear().
+template<typename T>
+class threadlocal {
+public:
+    threadlocal() : threadlocal(T()) {}
+    
+    // new instances are copies of initial_value
+    threadlocal(const T &initial_value) : exemplar(initial_value) {
+        exit_callback_handle = global_thread_registry.add_exit_callback(&threadlocal::on_thread_exit, this);
+    }
+    
+    // must not race with local() of other threads
+    ~threadlocal() {
+        global_thread_registry.remove_exit_callback(exit_callback_handle);
+        clear();
+    }
+    
+    threadlocal(const threadlocal&) = delete;
+    threadlocal& operator=(const threadlocal&) = delete;
+    
+public:
+    T &local() {
+        threadlocal_thread_id id = threadlocal_get_thread_id();
+        uint32_t chunk_index = id / THREADLOCAL_CHUNK_SIZE;
+        if(chunk_index < THREADLOCAL_MAX_CHUNKS) {
+            chunk_t *chunk = chunks[chunk_index].load(std::memory_order_acquire);
+            if(chunk != nullptr) {
+                // a slot is only written by the thread owning the id
+                element_t *element = chunk->slots[id & (THREADLOCAL_CHUNK_SIZE - 1)];
+                if(element != nullptr)
+                    return element->value;
+            }
+        }
+        return create_local(id);
+    }
+    
+    // calls func(T&) for the instance of every thread, exited ones included
+    template<typename func_t>
+    void for_each(func_t func) {
+        for(element_t *element = elements.load(std::memory_order_acquire); element != nullptr; element = element->next)
+            func(element->value);
+    }
+    
+    // folds every instance with op(T, T), returns the initial value if there is none
+    template<typename op_t>
+    T combine(op_t op) {
+        element_t *element = elements.load(std::memory_order_acquire);
+        if(element == nullptr)
+            return exemplar;
+        T result = element->value;
+        for(element = element->next; element != nullptr; element = element->next)
+            result = op(result, element->value);
+        return result;
+    }
+    
+    // destroys every instance (no thread may use local() meanwhile)
+    void clear() {
+        for(uint32_t i = 0; i < THREADLOCAL_MAX_CHUNKS; i++) {
+            delete chunks[i].exchange(nullptr, std::memory_order_acq_rel);
+        }
+        element_t *element = elements.exchange(nullptr, std::memory_order_acq_rel);
+        while(element != nullptr) {
+            element_t *next = element->next;
+            delete element;
+            element = next;
+        }
+    }
+    
+private:
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) element_t {
+        T value;
+        element_t *next = nullptr;
+        
+        element_t(const T &initial_value) : value(initial_value) {}
+    };
+    
+    struct chunk_t {
+        element_t *slots[THREADLOCAL_CHUNK_SIZE] = {};
+    };
+    
+    T &create_local(threadlocal_thread_id id) {
+        element_t *element = new element_t(exemplar);
+        element->next = elements.load(std::memory_order_relaxed);
+        while(!elements.compare_exchange_weak(element->next, element, std::memory_order_release, std::memory_order_relaxed));
+        
+        // exiting threads (released id) and ids beyond the table get an unindexed instance per call
+        uint32_t chunk_index = id / THREADLOCAL_CHUNK_SIZE;
+        if(chunk_index >= THREADLOCAL_MAX_CHUNKS)
+            return element->value;
+        
+        chunk_t *chunk = chunks[chunk_index].load(std::memory_order_acquire);
+        if(chunk == nullptr) {
+            chunk_t *new_chunk = new chunk_t();
+            if(chunks[chunk_index].compare_exchange_strong(chunk, new_chunk, std::memory_order_acq_rel))
+                chunk = new_chunk;
+            else
+                delete new_chunk;
+        }
+        chunk->slots[id & (THREADLOCAL_CHUNK_SIZE - 1)] = element;
+        return element->value;
+    }
+    
+    // runs on the exiting thread, its instance stays in the list
+    static void on_thread_exit(threadlocal_thread_id id, void *context) {
+        threadlocal *self = (threadlocal*)context;
+        uint32_t chunk_index = id / THREADLOCAL_CHUNK_SIZE;
+        if(chunk_index >= THREADLOCAL_MAX_CHUNKS)
+            return;
+        chunk_t *chunk = self->chunks[chunk_index].load(std::memory_order_acquire);
+        if(chunk != nullptr)
+            chunk->slots[id & (THREADLOCAL_CHUNK_SIZE - 1)] = nullptr;
+    }
+    
+private:
+    T exemplar;
+    uint64_t exit_callback_handle;
+    std::atomic<element_t*> elements{nullptr};
+    std::atomic<chunk_t*> chunks[THREADLOCAL_MAX_CHUNKS] = {};
+};
+
 #endif /* ThreadLocal_h */
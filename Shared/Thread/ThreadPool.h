@@ -0,0 +1,179 @@
+//
+//  ThreadPool.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef ThreadPool_h
+#define ThreadPool_h
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "ParkingPrimitives.h"
+#include "../LockFree/Mutex.h"
+#include "../../Platform/PlatformTopology.h"
+
+// Thread pool
+//
+// submit() queues fire-and-forget tasks. run() is a fork-join call : the
+// task indexes are claimed from a shared counter by the caller and by the
+// workers that pick the job up, and the caller takes back the queue entries
+// nobody picked, so nested run() calls from workers can't deadlock.
+class thread_pool {
+public:
+    // num_workers = 0 : one worker per usable cpu except the caller's
+    thread_pool(uint32_t num_workers = 0, platform::platform_placement placement = platform::platform_placement::none) {
+        if(num_workers == 0) {
+            uint32_t num_cpus = (uint32_t)platform::platform_get_topology().cpus.size();
+            num_workers = num_cpus > 1 ? num_cpus - 1 : 1;
+        }
+        // workers are pinned in placement order
+        std::vector<uint32_t> cpus = platform::platform_get_placement(placement, num_workers);
+        workers.reserve(num_workers);
+        for(uint32_t i = 0; i < num_workers; i++)
+            workers.push_back(std::thread(&thread_pool::worker_main, this, cpus.empty() ? -1 : (int)cpus[i]));
+    }
+    
+    ~thread_pool() {
+        {
+            scoped_lock<spinlock_mutex> lock{ &mutex };
+            stopping = true;
+        }
+        condition.notify_all();
+        for(std::thread &worker : workers)
+            worker.join();
+    }
+    
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+    
+public:
+    uint32_t get_worker_count() const { return (uint32_t)workers.size(); }
+    
+    void submit(std::function<void()> task) {
+        std::function<void()> *holder = new std::function<void()>(std::move(task));
+        push_entries({ &thread_pool::invoke_submitted, holder }, 1);
+    }
+    
+    // calls func(task_index) for every index in [0, num_tasks) and returns when all are done
+    template<typename func_t>
+    void run(size_t num_tasks, func_t func) {
+        if(num_tasks == 0)
+            return;
+        job_t job;
+        job.num_tasks = num_tasks;
+        job.context = &func;
+        job.invoke = [](void *context, size_t index) { (*(func_t*)context)(index); };
+        
+        size_t num_helpers = std::min<size_t>(num_tasks - 1, workers.size());
+        job.pending.store((uint32_t)num_helpers + 1, std::memory_order_relaxed);
+        if(num_helpers > 0)
+            push_entries({ &thread_pool::invoke_job, &job }, num_helpers);
+        
+        job.work();
+        
+        // entries still in the queue won't be needed anymore
+        size_t retracted = num_helpers > 0 ? retract_entries(&job) : 0;
+        if(job.pending.fetch_sub((uint32_t)retracted + 1, std::memory_order_acq_rel) != retracted + 1)
+            job.finished.wait();
+    }
+    
+private:
+    struct entry_t {
+        void (*invoke)(void*);
+        void *context;
+    };
+    
+    struct job_t {
+        std::atomic<size_t> next_task{0};
+        size_t num_tasks = 0;
+        void *context = nullptr;
+        void (*invoke)(void*, size_t) = nullptr;
+        // participants that haven't left yet (the caller included)
+        std::atomic<uint32_t> pending{0};
+        parking_event finished;
+        
+        void work() {
+            for(;;) {
+                size_t index = next_task.fetch_add(1, std::memory_order_relaxed);
+                if(index >= num_tasks)
+                    break;
+                invoke(context, index);
+            }
+        }
+    };
+    
+    static void invoke_submitted(void *context) {
+        std::function<void()> *holder = (std::function<void()>*)context;
+        (*holder)();
+        delete holder;
+    }
+    
+    static void invoke_job(void *context) {
+        job_t *job = (job_t*)context;
+        job->work();
+        // the caller may return as soon as this is observed, don't touch the job afterwards
+        if(job->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            job->finished.set();
+    }
+    
+    void push_entries(entry_t entry, size_t count) {
+        {
+            scoped_lock<spinlock_mutex> lock{ &mutex };
+            for(size_t i = 0; i < count; i++)
+                entries.push_back(entry);
+        }
+        if(count > 1)
+            condition.notify_all();
+        else
+            condition.notify_one();
+    }
+    
+    size_t retract_entries(job_t *job) {
+        scoped_lock<spinlock_mutex> lock{ &mutex };
+        size_t count = entries.size();
+        entries.erase(std::remove_if(entries.begin(), entries.end(), [job](const entry_t &entry) {
+            return entry.context == job;
+        }), entries.end());
+        return count - entries.size();
+    }
+    
+    void worker_main(int cpu) {
+        if(cpu >= 0)
+            platform::platform_pin_current_thread((uint32_t)cpu);
+        for(;;) {
+            entry_t entry;
+            {
+                scoped_lock<spinlock_mutex> lock{ &mutex };
+                while(entries.empty() && !stopping)
+                    condition.wait(mutex);
+                if(entries.empty())
+                    return;
+                entry = entries.front();
+                entries.pop_front();
+            }
+            entry.invoke(entry.context);
+        }
+    }
+    
+private:
+    spinlock_mutex mutex;
+    parking_condition condition;
+    std::deque<entry_t> entries;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+};
+
+// shared pool for the parallel algorithms (created on first use)
+inline thread_pool &get_global_thread_pool() {
+    static thread_pool pool;
+    return pool;
+}
+
+#endif /* ThreadPool_h */
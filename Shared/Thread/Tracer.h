@@ -0,0 +1,373 @@
+//
+//  Tracer.h
+//  CppPlayground
+//
+//  Created by 이현우 on 2026/10/19.
+//
+
+#ifndef Tracer_h
+#define Tracer_h
+
+#include "../../Option/Option.h"
+
+#if USE_TRACE
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "ThreadLocal.h"
+#include "../../Platform/PlatformDefine.h"
+
+#if (__x86_64__ || __i386__) && __GNUC__
+#include <x86intrin.h>
+#elif (_M_X64 || _M_IX86) && _MSC_VER
+#include <intrin.h>
+#endif
+
+// events per thread ring (must be power of 2)
+#define TRACE_RING_SIZE 8192
+
+// interval of the background flusher
+#define TRACE_FLUSH_INTERVAL_MS 1
+
+// first bytes of a binary trace file
+#define TRACE_FILE_MAGIC "CPTRACE1"
+
+// cpu timestamp counter (steady_clock ns where there is none)
+inline uint64_t trace_timestamp() {
+#if ((__x86_64__ || __i386__) && __GNUC__) || ((_M_X64 || _M_IX86) && _MSC_VER)
+    return __rdtsc();
+#elif __aarch64__ && __GNUC__
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r" (ticks));
+    return ticks;
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+enum trace_event_type : uint32_t {
+    TRACE_EVENT_BEGIN,
+    TRACE_EVENT_END,
+    TRACE_EVENT_INSTANT,
+    TRACE_EVENT_COUNTER,
+    // value is the lock address
+    TRACE_EVENT_LOCK_WAIT,
+    TRACE_EVENT_LOCK_ACQUIRE,
+    // file-only records : name string (value is its length, the bytes follow) and clock
+    TRACE_EVENT_STRING,
+    TRACE_EVENT_CLOCK,
+};
+
+// fixed-size binary event (the name is a string literal, its address is the id)
+struct trace_event_t {
+    uint64_t timestamp;
+    uint64_t name;
+    int64_t value;
+    uint32_t thread_id;
+    uint32_t type;
+};
+
+// Event tracer
+//
+// Each thread records into its own single-producer ring without locks or
+// allocations (events are dropped when the ring is full). A background
+// flusher drains the rings into a binary file every TRACE_FLUSH_INTERVAL_MS;
+// convert_to_chrome_json() turns the file into the Chrome/Perfetto format.
+// Recording is a relaxed load while the tracer is stopped.
+class tracer {
+public:
+    tracer() {}
+
+    ~tracer() {
+        stop();
+        for(buffer_t *buffer : buffers)
+            delete buffer;
+    }
+
+    tracer(const tracer&) = delete;
+    tracer& operator=(const tracer&) = delete;
+
+public:
+    bool start(const char *path) {
+        std::lock_guard<std::mutex> lock(control_mutex);
+        if(file != nullptr)
+            return false;
+        file = std::fopen(path, "wb");
+        if(file == nullptr)
+            return false;
+        std::fwrite(TRACE_FILE_MAGIC, 1, 8, file);
+        written_names.clear();
+        {
+            // events left from the previous session are skipped
+            std::lock_guard<std::mutex> buffers_lock(buffers_mutex);
+            for(buffer_t *buffer : buffers)
+                buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+        }
+        start_ticks = trace_timestamp();
+        start_time = std::chrono::steady_clock::now();
+        write_clock(start_ticks, 0);
+        running.store(true);
+        enabled.store(true, std::memory_order_release);
+        flusher = std::thread(&tracer::flusher_main, this);
+        return true;
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> lock(control_mutex);
+        if(file == nullptr)
+            return;
+        enabled.store(false, std::memory_order_release);
+        running.store(false);
+        flusher.join();
+        drain();
+        // the tick rate is measured over the whole session
+        uint64_t ticks = trace_timestamp() - start_ticks;
+        int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time).count();
+        write_clock(start_ticks, ns > 0 ? (int64_t)((double)ticks * 1000000.0 / ns) : 1000000);
+        std::fclose(file);
+        file = nullptr;
+    }
+
+    inline bool is_enabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    inline void record(trace_event_type type, const char *name, int64_t value) {
+        if(!enabled.load(std::memory_order_relaxed))
+            return;
+        buffer_t *buffer = get_buffer();
+        if(buffer == nullptr)
+            return;
+        uint64_t head = buffer->head.load(std::memory_order_relaxed);
+        if(head - buffer->tail.load(std::memory_order_acquire) >= TRACE_RING_SIZE) {
+            buffer->dropped.store(buffer->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+        trace_event_t &event = buffer->events[head & (TRACE_RING_SIZE - 1)];
+        event.timestamp = trace_timestamp();
+        event.name = (uint64_t)(uintptr_t)name;
+        event.value = value;
+        event.thread_id = buffer->thread_id;
+        event.type = type;
+        buffer->head.store(head + 1, std::memory_order_release);
+    }
+
+    // events lost to full rings
+    uint64_t get_dropped_count() {
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        uint64_t dropped = retired_dropped;
+        for(buffer_t *buffer : buffers)
+            dropped += buffer->dropped.load(std::memory_order_relaxed);
+        return dropped;
+    }
+
+    // writes the binary trace as Chrome trace event JSON
+    static bool convert_to_chrome_json(const char *binary_path, const char *json_path) {
+        FILE *in = std::fopen(binary_path, "rb");
+        if(in == nullptr)
+            return false;
+        char magic[8];
+        if(std::fread(magic, 1, 8, in) != 8 || std::memcmp(magic, TRACE_FILE_MAGIC, 8) != 0) {
+            std::fclose(in);
+            return false;
+        }
+        std::map<uint64_t, std::string> names;
+        std::vector<trace_event_t> events;
+        uint64_t base_ticks = 0;
+        int64_t ticks_per_ms = 1000000;
+        trace_event_t event;
+        while(std::fread(&event, sizeof(event), 1, in) == 1) {
+            if(event.type == TRACE_EVENT_STRING) {
+                std::string name((size_t)event.value, '\0');
+                if(event.value > 0 && std::fread(&name[0], 1, (size_t)event.value, in) != (size_t)event.value)
+                    break;
+                names[event.name] = name;
+            }
+            else if(event.type == TRACE_EVENT_CLOCK) {
+                base_ticks = event.timestamp;
+                if(event.value > 0)
+                    ticks_per_ms = event.value;
+            }
+            else {
+                events.push_back(event);
+            }
+        }
+        std::fclose(in);
+
+        FILE *out = std::fopen(json_path, "w");
+        if(out == nullptr)
+            return false;
+        std::fprintf(out, "{\"traceEvents\":[\n");
+        for(size_t i = 0; i < events.size(); i++) {
+            const trace_event_t &e = events[i];
+            double ts_us = (double)(int64_t)(e.timestamp - base_ticks) * 1000.0 / ticks_per_ms;
+            const std::string &name = names[e.name];
+            std::fprintf(out, "%s{\"pid\":1,\"tid\":%u,\"ts\":%.3f,", i > 0 ? ",\n" : "", e.thread_id, ts_us);
+            switch(e.type) {
+                case TRACE_EVENT_BEGIN: std::fprintf(out, "\"ph\":\"B\",\"name\":\"%s\"}", name.c_str()); break;
+                case TRACE_EVENT_END: std::fprintf(out, "\"ph\":\"E\",\"name\":\"%s\"}", name.c_str()); break;
+                case TRACE_EVENT_INSTANT: std::fprintf(out, "\"ph\":\"i\",\"s\":\"t\",\"name\":\"%s\"}", name.c_str()); break;
+                case TRACE_EVENT_COUNTER: std::fprintf(out, "\"ph\":\"C\",\"name\":\"%s\",\"args\":{\"value\":%lld}}", name.c_str(), (long long)e.value); break;
+                case TRACE_EVENT_LOCK_WAIT: std::fprintf(out, "\"ph\":\"B\",\"name\":\"%s wait\",\"args\":{\"lock\":\"0x%llx\"}}", name.c_str(), (unsigned long long)e.value); break;
+                default: std::fprintf(out, "\"ph\":\"E\",\"name\":\"%s wait\"}", name.c_str()); break;
+            }
+        }
+        std::fprintf(out, "\n],\"displayTimeUnit\":\"ns\"}\n");
+        std::fclose(out);
+        return true;
+    }
+
+private:
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) buffer_t {
+        // written by the owner thread
+        alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64_t> head{0};
+        std::atomic<uint64_t> dropped{0};
+        // written by the flusher
+        alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64_t> tail{0};
+        std::atomic<bool> exited{false};
+        uint32_t thread_id = 0;
+        trace_event_t events[TRACE_RING_SIZE];
+    };
+
+    // marks the buffer of the thread for removal on thread exit
+    class threadlocal_buffer_t {
+    public:
+        threadlocal_buffer_t() : owner(nullptr), buffer(nullptr), destroyed(false) {}
+
+        ~threadlocal_buffer_t() {
+            if(buffer != nullptr)
+                buffer->exited.store(true, std::memory_order_release);
+            owner = nullptr;
+            buffer = nullptr;
+            destroyed = true;
+        }
+
+        tracer *owner;
+        buffer_t *buffer;
+        // thread_local destructors running later must not record anymore
+        bool destroyed;
+    };
+
+    inline static thread_local threadlocal_buffer_t threadlocal_buffer;
+
+private:
+    buffer_t *get_buffer() {
+        threadlocal_buffer_t &tls = threadlocal_buffer;
+        if(tls.owner == this)
+            return tls.buffer;
+        if(tls.destroyed)
+            return nullptr;
+        // a thread records into a single tracer (normally the global one)
+        buffer_t *buffer = new buffer_t();
+        buffer->thread_id = threadlocal_get_thread_id();
+        {
+            std::lock_guard<std::mutex> lock(buffers_mutex);
+            buffers.push_back(buffer);
+        }
+        tls.owner = this;
+        tls.buffer = buffer;
+        return buffer;
+    }
+
+    void flusher_main() {
+        while(running.load()) {
+            drain();
+            std::this_thread::sleep_for(std::chrono::milliseconds(TRACE_FLUSH_INTERVAL_MS));
+        }
+    }
+
+    // called by the flusher, or by stop() after it has exited
+    void drain() {
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        for(size_t i = 0; i < buffers.size(); i++) {
+            buffer_t *buffer = buffers[i];
+            bool exited = buffer->exited.load(std::memory_order_acquire);
+            uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+            uint64_t head = buffer->head.load(std::memory_order_acquire);
+            for(; tail != head; tail++)
+                write_event(buffer->events[tail & (TRACE_RING_SIZE - 1)]);
+            buffer->tail.store(tail, std::memory_order_release);
+            if(exited) {
+                retired_dropped += buffer->dropped.load(std::memory_order_relaxed);
+                delete buffer;
+                buffers[i--] = buffers.back();
+                buffers.pop_back();
+            }
+        }
+        std::fflush(file);
+    }
+
+    void write_event(const trace_event_t &event) {
+        if(written_names.insert(event.name).second) {
+            const char *name = (const char*)(uintptr_t)event.name;
+            trace_event_t string_event = { 0, event.name, (int64_t)std::strlen(name), 0, TRACE_EVENT_STRING };
+            std::fwrite(&string_event, sizeof(string_event), 1, file);
+            std::fwrite(name, 1, (size_t)string_event.value, file);
+        }
+        std::fwrite(&event, sizeof(event), 1, file);
+    }
+
+    void write_clock(uint64_t base_ticks, int64_t ticks_per_ms) {
+        trace_event_t clock_event = { base_ticks, 0, ticks_per_ms, 0, TRACE_EVENT_CLOCK };
+        std::fwrite(&clock_event, sizeof(clock_event), 1, file);
+    }
+
+private:
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<bool> enabled{false};
+    std::atomic<bool> running{false};
+    std::mutex control_mutex;
+    std::mutex buffers_mutex;
+    std::vector<buffer_t*> buffers;
+    uint64_t retired_dropped = 0;
+    // flusher state
+    FILE *file = nullptr;
+    std::unordered_set<uint64_t> written_names;
+    std::thread flusher;
+    uint64_t start_ticks = 0;
+    std::chrono::steady_clock::time_point start_time;
+};
+
+inline tracer global_tracer;
+
+// ends the span when going out of scope
+class trace_scope {
+public:
+    trace_scope(const char *in_name) : name(in_name) { global_tracer.record(TRACE_EVENT_BEGIN, name, 0); }
+    ~trace_scope() { global_tracer.record(TRACE_EVENT_END, name, 0); }
+
+private:
+    const char *name;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+// names must be string literals
+#define TRACE_SCOPE(name) trace_scope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#define TRACE_BEGIN(name) global_tracer.record(TRACE_EVENT_BEGIN, name, 0)
+#define TRACE_END(name) global_tracer.record(TRACE_EVENT_END, name, 0)
+#define TRACE_INSTANT(name) global_tracer.record(TRACE_EVENT_INSTANT, name, 0)
+#define TRACE_COUNTER(name, value) global_tracer.record(TRACE_EVENT_COUNTER, name, (int64_t)(value))
+#define TRACE_LOCK_WAIT(name, lock) global_tracer.record(TRACE_EVENT_LOCK_WAIT, name, (int64_t)(uintptr_t)(lock))
+#define TRACE_LOCK_ACQUIRE(name, lock) global_tracer.record(TRACE_EVENT_LOCK_ACQUIRE, name, (int64_t)(uintptr_t)(lock))
+
+#else
+
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_BEGIN(name) ((void)0)
+#define TRACE_END(name) ((void)0)
+#define TRACE_INSTANT(name) ((void)0)
+#define TRACE_COUNTER(name, value) ((void)0)
+#define TRACE_LOCK_WAIT(name, lock) ((void)0)
+#define TRACE_LOCK_ACQUIRE(name, lock) ((void)0)
+
+#endif
+
+#endif /* Tracer_h */